@@ -0,0 +1,73 @@
+/*
+  Copyright 2025 Peter Duanmu
+
+  You should have received a copy of the GNU General Public License along
+  with discord_ipc_cpp. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef DISCORD_IPC_CPP_BENCH_BENCH_UTILS_HPP_
+#define DISCORD_IPC_CPP_BENCH_BENCH_UTILS_HPP_
+
+#include <algorithm>
+#include <cstdio>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace discord_ipc_cpp::bench {
+/**
+ * \brief Distribution of a set of samples.
+ */
+struct Summary {
+  size_t samples;
+  double min;
+  double mean;
+  double p50;
+  double p90;
+  double p99;
+  double max;
+};
+
+/**
+ * \brief Summarizes \p samples.
+ */
+inline Summary summarize(std::vector<double> samples) {
+  if (samples.empty()) {
+    return {};
+  }
+
+  std::sort(samples.begin(), samples.end());
+
+  auto percentile = [&](double p) {
+    return samples[static_cast<size_t>(p * (samples.size() - 1))];
+  };
+
+  return {
+    .samples = samples.size(),
+    .min = samples.front(),
+    .mean = std::accumulate(samples.begin(), samples.end(), 0.0) /
+            samples.size(),
+    .p50 = percentile(0.50),
+    .p90 = percentile(0.90),
+    .p99 = percentile(0.99),
+    .max = samples.back()
+  };
+}
+
+/**
+ * \brief Prints \p summary as a single table row.
+ */
+inline void print_summary(
+  const std::string& name, const std::string& unit, const Summary& summary
+) {
+  std::printf(
+    "%-32s n=%-7zu min=%.2f%s p50=%.2f%s p90=%.2f%s p99=%.2f%s max=%.2f%s "
+    "mean=%.2f%s\n",
+    name.c_str(), summary.samples,
+    summary.min, unit.c_str(), summary.p50, unit.c_str(),
+    summary.p90, unit.c_str(), summary.p99, unit.c_str(),
+    summary.max, unit.c_str(), summary.mean, unit.c_str());
+}
+}  // namespace discord_ipc_cpp::bench
+
+#endif  // DISCORD_IPC_CPP_BENCH_BENCH_UTILS_HPP_
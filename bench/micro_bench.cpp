@@ -0,0 +1,259 @@
+/*
+  Copyright 2025 Peter Duanmu
+
+  You should have received a copy of the GNU General Public License along
+  with discord_ipc_cpp. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+// Times the hot paths of building, serializing and parsing IPC frames. Each
+// benchmark repeats its operation until a sample takes at least a millisecond,
+// and reports the time per operation across samples. Results are written to
+// stdout as JSON so runs can be diffed against a stored baseline, while a
+// readable table goes to stderr.
+//
+// Usage: discord_ipc_cpp_bench [samples] [filter]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "discord_ipc_cpp/discord_ipc_client.hpp"
+#include "discord_ipc_cpp/ipc_types.hpp"
+#include "discord_ipc_cpp/json.hpp"
+#include "discord_ipc_cpp/parser.hpp"
+
+#include "include/internal_ipc_types.hpp"
+#include "include/utils.hpp"
+
+#include "bench_utils.hpp"
+
+namespace {
+using discord_ipc_cpp::DiscordIPCClient;
+using discord_ipc_cpp::internal_ipc_types::CommandRequest;
+using discord_ipc_cpp::ipc_types::Opcode;
+using discord_ipc_cpp::ipc_types::Payload;
+using discord_ipc_cpp::ipc_types::RichPresence;
+using discord_ipc_cpp::json::JSON;
+using discord_ipc_cpp::json::JSONArray;
+using discord_ipc_cpp::json::Parser;
+
+namespace bench = discord_ipc_cpp::bench;
+namespace utils = discord_ipc_cpp::utils;
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * \brief Exposes the packet encoder to the benchmarks.
+ */
+class EncodingClient : public DiscordIPCClient {
+ public:
+  using DiscordIPCClient::encode_packet;
+};
+
+/**
+ * \brief Keeps the compiler from discarding a computed value.
+ */
+template<typename T>
+void keep(const T& value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * \brief Operation to time.
+ */
+struct Benchmark {
+  std::string name;
+  std::function<void()> operation;
+};
+
+/**
+ * \brief Times \p operation, returning nanoseconds per call for each sample.
+ */
+std::vector<double> measure(const std::function<void()>& operation,
+                            size_t samples) {
+  static constexpr auto min_sample = std::chrono::milliseconds(1);
+
+  size_t iterations = 1;
+
+  // warms up while finding how many calls fill a sample
+  while (true) {
+    auto start = Clock::now();
+
+    for (size_t i = 0; i < iterations; ++i) {
+      operation();
+    }
+
+    if (Clock::now() - start >= min_sample) {
+      break;
+    }
+
+    iterations *= 2;
+  }
+
+  std::vector<double> results;
+
+  results.reserve(samples);
+
+  for (size_t s = 0; s < samples; ++s) {
+    auto start = Clock::now();
+
+    for (size_t i = 0; i < iterations; ++i) {
+      operation();
+    }
+
+    results.push_back(
+      std::chrono::duration<double, std::nano>(Clock::now() - start).count() /
+      iterations);
+  }
+
+  return results;
+}
+
+const std::string ready_frame =
+  R"({"cmd":"DISPATCH","data":{"v":1,"config":{"cdn_host":)"
+  R"("cdn.discordapp.com","api_endpoint":"//discord.com/api",)"
+  R"("environment":"production"},"user":{"id":"123456789012345678",)"
+  R"("username":"minami","discriminator":"0","global_name":"Minami",)"
+  R"("avatar":"a_0123456789abcdef0123456789abcdef",)"
+  R"("avatar_decoration_data":null,"bot":false,"flags":32,)"
+  R"("premium_type":2}},"evt":"READY","nonce":null})";
+
+const std::string set_activity_reply =
+  R"({"cmd":"SET_ACTIVITY","data":{"name":"Apple Music","type":2,)"
+  R"("details":"Hollowness","state":"Minami","assets":{"large_image":)"
+  R"("https://example.com/artwork.jpg","large_text":"Kawakiwoameku - EP"},)"
+  R"("timestamps":{"start":1700000000000,"end":1700000215000},)"
+  R"("buttons":["Listen"],"application_id":"1234567890",)"
+  R"("created_at":1700000000123},"evt":null,)"
+  R"("nonce":"4f1c2a9e-8b3d-4e6f-a1b2-c3d4e5f60718"})";
+
+const std::string error_reply =
+  R"({"cmd":"SET_ACTIVITY","data":{"code":4000,"message":)"
+  R"("child \"activity\" fails because [child \"details\" fails because )"
+  R"([\"details\" length must be less than or equal to 128 characters )"
+  R"(long]]"},"evt":"ERROR","nonce":"4f1c2a9e-8b3d-4e6f-a1b2-c3d4e5f60718"})";
+
+RichPresence sample_presence() {
+  RichPresence presence = {
+    .name = "Apple Music",
+    .type = RichPresence::at_listening,
+    .timestamps = RichPresence::Timestamps {
+      .start = 1700000000,
+      .end = 1700000215
+    },
+    .status_display_type = RichPresence::sdt_details,
+    .details = "Hollowness",
+    .state = "Minami",
+    .buttons = std::vector<RichPresence::Button> {
+      { .label = "Listen", .url = "https://example.com/listen" }
+    }
+  };
+
+  auto& assets = presence.assets.emplace();
+
+  assets.large_image = "https://example.com/artwork.jpg";
+  assets.large_text = "Kawakiwoameku - EP";
+
+  return presence;
+}
+
+std::vector<Benchmark> make_benchmarks() {
+  RichPresence presence = sample_presence();
+  JSON command = Parser::parse(set_activity_reply);
+  JSON presence_command({
+    { "cmd", JSON("SET_ACTIVITY") },
+    { "args", JSON({
+      { "pid", JSON(4242) },
+      { "activity", presence.to_json() }
+    }) },
+    { "nonce", JSON(utils::generate_uuid()) }
+  });
+  Payload payload { Opcode::op_frame, presence_command };
+  std::string escaped = R"(say \"hi\" to \"everyone\" in the \"party\")";
+  std::string unescaped = R"(say "hi" to "everyone" in the "party")";
+
+  return {
+    { "json_construct", []() {
+        JSON value({
+          { "name", JSON("Apple Music") },
+          { "type", JSON(2) },
+          { "details", JSON("Hollowness") },
+          { "state", JSON("Minami") },
+          { "timestamps", JSON({
+            { "start", JSON(int64_t { 1700000000 }) },
+            { "end", JSON(int64_t { 1700000215 }) }
+          }) },
+          { "buttons", JSON(JSONArray { JSON("Listen") }) }
+        });
+
+        keep(value);
+      } },
+    { "json_to_string", [presence_command]() {
+        keep(presence_command.to_string());
+      } },
+    { "parse_ready", []() { keep(Parser::parse(ready_frame)); } },
+    { "parse_set_activity_reply", []() {
+        keep(Parser::parse(set_activity_reply));
+      } },
+    { "parse_error_reply", []() { keep(Parser::parse(error_reply)); } },
+    { "escape_string", [unescaped]() {
+        keep(utils::escape_string(unescaped));
+      } },
+    { "unescape_string", [escaped]() {
+        keep(utils::unescape_string(escaped));
+      } },
+    { "generate_uuid", []() { keep(utils::generate_uuid()); } },
+    { "encode_packet", [payload]() {
+        keep(EncodingClient::encode_packet(payload));
+      } },
+    { "command_from_json", [command]() {
+        keep(CommandRequest::from_json(command));
+      } },
+    { "rich_presence_to_json", [presence]() { keep(presence.to_json()); } }
+  };
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  size_t samples = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 30;
+  std::string filter = argc > 2 ? argv[2] : "";
+
+  if (samples == 0) {
+    samples = 1;
+  }
+
+  std::printf("{\n  \"unit\": \"ns\",\n  \"samples\": %zu,\n"
+              "  \"benchmarks\": [", samples);
+
+  bool first = true;
+
+  for (const auto& benchmark : make_benchmarks()) {
+    if (benchmark.name.find(filter) == std::string::npos) {
+      continue;
+    }
+
+    bench::Summary summary = bench::summarize(
+      measure(benchmark.operation, samples));
+
+    std::fprintf(stderr,
+                 "%-32s p50=%.1fns p90=%.1fns p99=%.1fns min=%.1fns\n",
+                 benchmark.name.c_str(), summary.p50, summary.p90,
+                 summary.p99, summary.min);
+
+    std::printf(
+      "%s\n    { \"name\": \"%s\", \"min\": %.2f, \"mean\": %.2f, "
+      "\"p50\": %.2f, \"p90\": %.2f, \"p99\": %.2f, \"max\": %.2f }",
+      first ? "" : ",", benchmark.name.c_str(), summary.min, summary.mean,
+      summary.p50, summary.p90, summary.p99, summary.max);
+
+    first = false;
+  }
+
+  std::printf("\n  ]\n}\n");
+
+  return 0;
+}
@@ -0,0 +1,212 @@
+/*
+  Copyright 2025 Peter Duanmu
+
+  You should have received a copy of the GNU General Public License along
+  with discord_ipc_cpp. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+// Compares the lock-free SPSC and MPSC queues against a mutex-based queue,
+// measuring one-way handoff latency and throughput between threads.
+//
+// Usage: discord_ipc_cpp_queue_bench [items] [producers]
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "discord_ipc_cpp/mpsc_queue.hpp"
+#include "discord_ipc_cpp/spsc_queue.hpp"
+
+#include "bench_utils.hpp"
+
+namespace {
+using discord_ipc_cpp::queues::MpscQueue;
+using discord_ipc_cpp::queues::SpscQueue;
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * \brief Bounded queue guarded by a mutex, as a baseline.
+ */
+template<typename T>
+class MutexQueue {
+ private:
+  std::mutex _mutex;
+  std::deque<T> _items;
+  size_t _capacity;
+
+ public:
+  explicit MutexQueue(size_t capacity) : _capacity(capacity) {}
+
+  bool try_push(T value) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_items.size() >= _capacity) {
+      return false;
+    }
+
+    _items.push_back(std::move(value));
+
+    return true;
+  }
+
+  bool try_pop(T* value) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_items.empty()) {
+      return false;
+    }
+
+    *value = std::move(_items.front());
+    _items.pop_front();
+
+    return true;
+  }
+};
+
+int64_t now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    Clock::now().time_since_epoch()).count();
+}
+
+/**
+ * \brief Measures the time from push to pop of a single in-flight item.
+ */
+template<typename Queue>
+std::vector<double> handoff_latency(size_t samples) {
+  Queue queue(1024);
+  std::atomic<size_t> received { 0 };
+  std::vector<double> latencies;
+
+  latencies.reserve(samples);
+
+  std::thread consumer([&]() {
+    int64_t sent_at;
+
+    while (received.load(std::memory_order_relaxed) < samples) {
+      if (queue.try_pop(&sent_at)) {
+        latencies.push_back(static_cast<double>(now_ns() - sent_at));
+
+        received.fetch_add(1, std::memory_order_release);
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  for (size_t i = 0; i < samples; ++i) {
+    while (!queue.try_push(now_ns())) {
+      std::this_thread::yield();
+    }
+
+    while (received.load(std::memory_order_acquire) <= i) {
+      std::this_thread::yield();
+    }
+  }
+
+  consumer.join();
+
+  return latencies;
+}
+
+/**
+ * \brief Measures items per second moved from \p producers threads to one
+ *        consumer.
+ */
+template<typename Queue>
+double throughput(size_t items, size_t producers) {
+  Queue queue(1024);
+  size_t per_producer = items / producers;
+  std::atomic_bool start { false };
+  std::vector<std::thread> threads;
+
+  for (size_t p = 0; p < producers; ++p) {
+    threads.emplace_back([&]() {
+      while (!start.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+      }
+
+      for (size_t i = 0; i < per_producer; ++i) {
+        while (!queue.try_push(static_cast<int64_t>(i))) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  auto begin = Clock::now();
+
+  start.store(true, std::memory_order_release);
+
+  int64_t value;
+
+  for (size_t received = 0; received < per_producer * producers;) {
+    if (queue.try_pop(&value)) {
+      ++received;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+
+  double seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  return per_producer * producers / seconds / 1e6;
+}
+
+template<typename Queue>
+void run_throughput(
+  const std::string& name, size_t items, size_t producers, int runs
+) {
+  std::vector<double> samples;
+
+  for (int i = 0; i < runs; ++i) {
+    samples.push_back(throughput<Queue>(items, producers));
+  }
+
+  discord_ipc_cpp::bench::print_summary(
+    name, "M/s", discord_ipc_cpp::bench::summarize(samples));
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  size_t items = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+  size_t producers = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 4;
+  size_t samples = 20000;
+  int runs = 5;
+
+  discord_ipc_cpp::bench::print_summary(
+    "spsc_handoff_latency", "ns",
+    discord_ipc_cpp::bench::summarize(
+      handoff_latency<SpscQueue<int64_t>>(samples)));
+  discord_ipc_cpp::bench::print_summary(
+    "mpsc_handoff_latency", "ns",
+    discord_ipc_cpp::bench::summarize(
+      handoff_latency<MpscQueue<int64_t>>(samples)));
+  discord_ipc_cpp::bench::print_summary(
+    "mutex_handoff_latency", "ns",
+    discord_ipc_cpp::bench::summarize(
+      handoff_latency<MutexQueue<int64_t>>(samples)));
+
+  run_throughput<SpscQueue<int64_t>>("spsc_throughput_1p", items, 1, runs);
+  run_throughput<MutexQueue<int64_t>>("mutex_throughput_1p", items, 1, runs);
+
+  run_throughput<MpscQueue<int64_t>>(
+    "mpsc_throughput_" + std::to_string(producers) + "p",
+    items, producers, runs);
+  run_throughput<MutexQueue<int64_t>>(
+    "mutex_throughput_" + std::to_string(producers) + "p",
+    items, producers, runs);
+
+  return 0;
+}
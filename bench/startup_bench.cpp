@@ -0,0 +1,201 @@
+/*
+  Copyright 2025 Peter Duanmu
+
+  You should have received a copy of the GNU General Public License along
+  with discord_ipc_cpp. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+// Measures the latency from DiscordIPCClient::connect() until the first
+// SET_ACTIVITY frame reaches a local stand-in for Discord's IPC server.
+//
+// Usage: discord_ipc_cpp_startup_bench [iterations] [ready_delay_us]
+
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "discord_ipc_cpp/discord_ipc_client.hpp"
+#include "discord_ipc_cpp/ipc_types.hpp"
+#include "discord_ipc_cpp/socket_client.hpp"
+
+#include "bench_utils.hpp"
+
+namespace {
+using discord_ipc_cpp::DiscordIPCClient;
+using discord_ipc_cpp::ipc_types::RichPresence;
+using discord_ipc_cpp::websockets::SocketClient;
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * \brief Minimal stand-in for Discord's IPC server.
+ *
+ * Accepts a single client per call to \ref serve_one, answers the handshake
+ * with a \c READY dispatch and reports when the first command frame arrives.
+ */
+class StandInServer {
+ private:
+  std::string _dir;
+  std::string _path;
+  int _listen_fd;
+
+  static bool read_exact(int fd, char* buffer, size_t size) {
+    while (size > 0) {
+      ssize_t ret = ::recv(fd, buffer, size, 0);
+
+      if (ret <= 0) {
+        return false;
+      }
+
+      buffer += ret;
+      size -= ret;
+    }
+
+    return true;
+  }
+
+  static bool read_frame(int fd, int* opcode, std::string* body) {
+    char header[8];
+    int length;
+
+    if (!read_exact(fd, header, 8)) {
+      return false;
+    }
+
+    std::memcpy(opcode, header, 4);
+    std::memcpy(&length, header + 4, 4);
+
+    body->resize(length);
+
+    return read_exact(fd, body->data(), length);
+  }
+
+  static void write_frame(int fd, int opcode, const std::string& body) {
+    std::vector<char> frame(8 + body.size());
+    int length = body.size();
+
+    std::memcpy(&frame[0], &opcode, 4);
+    std::memcpy(&frame[4], &length, 4);
+    std::memcpy(&frame[8], body.data(), body.size());
+
+    ::send(fd, frame.data(), frame.size(), 0);
+  }
+
+ public:
+  StandInServer() {
+    char dir_template[] = "/tmp/discord_ipc_bench_XXXXXX";
+
+    _dir = ::mkdtemp(dir_template);
+    _path = _dir + "/discord-ipc-0";
+
+    struct sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, _path.c_str(), sizeof(addr.sun_path) - 1);
+
+    _listen_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    ::bind(_listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    ::listen(_listen_fd, 1);
+  }
+
+  ~StandInServer() {
+    ::close(_listen_fd);
+    ::unlink(_path.c_str());
+    ::rmdir(_dir.c_str());
+  }
+
+  const std::string& path() const {
+    return _path;
+  }
+
+  void serve_one(
+    std::chrono::microseconds ready_delay,
+    std::promise<Clock::time_point>* first_command
+  ) {
+    int fd = ::accept(_listen_fd, nullptr, nullptr);
+    int opcode;
+    std::string body;
+    bool reported = false;
+
+    while (read_frame(fd, &opcode, &body)) {
+      if (opcode == 0) {
+        std::this_thread::sleep_for(ready_delay);
+
+        write_frame(fd, 1,
+          R"({"cmd":"DISPATCH","data":{"v":1},"evt":"READY","nonce":null})");
+      } else if (opcode == 1 && !reported) {
+        first_command->set_value(Clock::now());
+
+        reported = true;
+      } else if (opcode == 2) {
+        break;
+      }
+    }
+
+    ::close(fd);
+  }
+};
+}  // namespace
+
+int main(int argc, char** argv) {
+  int iterations = argc > 1 ? std::atoi(argv[1]) : 50;
+  std::chrono::microseconds ready_delay(argc > 2 ? std::atoi(argv[2]) : 0);
+
+  // the stand-in server hangs up as soon as it reads the closure frame
+  ::signal(SIGPIPE, SIG_IGN);
+
+  StandInServer server;
+  std::vector<double> samples;
+
+  RichPresence presence = {
+    .name = "Apple Music",
+    .type = RichPresence::at_listening,
+    .details = "Hollowness",
+    .state = "Minami"
+  };
+
+  for (int i = 0; i < iterations; ++i) {
+    std::promise<Clock::time_point> first_command;
+    std::thread server_thread(
+      &StandInServer::serve_one, &server, ready_delay, &first_command);
+
+    {
+      DiscordIPCClient client(
+        "1234567890", std::make_unique<SocketClient>(server.path()));
+
+      auto start = Clock::now();
+
+      if (!client.connect() || !client.set_presence(presence)) {
+        std::fprintf(stderr, "failed to reach stand-in server\n");
+
+        std::exit(1);
+      }
+
+      auto arrived = first_command.get_future().get();
+
+      samples.push_back(
+        std::chrono::duration<double, std::micro>(arrived - start).count());
+
+      client.close();
+    }
+
+    server_thread.join();
+  }
+
+  discord_ipc_cpp::bench::print_summary(
+    "connect_to_first_presence", "us",
+    discord_ipc_cpp::bench::summarize(samples));
+
+  return 0;
+}
@@ -0,0 +1,128 @@
+/*
+  Copyright 2025 Peter Duanmu
+
+  You should have received a copy of the GNU General Public License along
+  with discord_ipc_cpp. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_AWAITABLE_HPP_
+#define DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_AWAITABLE_HPP_
+
+#include <atomic>
+#include <coroutine>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace discord_ipc_cpp {
+/**
+ * \brief Awaitable result of an asynchronous client operation.
+ *
+ * Wraps a callback-based operation so it can be awaited with \c co_await from
+ * any C++20 coroutine. The operation is only started once awaited, and the
+ * awaiting coroutine is resumed on the thread that completes the operation,
+ * which is usually the client's receive thread. No additional threads are
+ * created.
+ *
+ * \tparam T Result of the operation.
+ *
+ * \note Each awaitable may only be awaited once.
+ *
+ * \see discord_ipc_cpp::DiscordIPCClient::async_connect
+ * \see discord_ipc_cpp::DiscordIPCClient::async_set_presence
+ */
+template<typename T>
+class Awaitable {
+ public:
+  /**
+   * \brief Callback that completes the operation with its result.
+   */
+  using Completion = std::function<void(T)>;
+  /**
+   * \brief Function that starts the operation.
+   */
+  using Starter = std::function<void(Completion)>;
+
+ private:
+  /**
+   * \brief State shared between the awaiter and the completion.
+   */
+  struct State {
+    /**
+     * \brief Result of the operation once completed.
+     */
+    std::optional<T> result;
+    /**
+     * \brief Coroutine awaiting the result.
+     */
+    std::coroutine_handle<> handle;
+    /**
+     * \brief Progress of the handshake between suspension and completion.
+     *
+     * Set to \c 1 by the completion and to \c 2 once the coroutine has been
+     * suspended. Whichever side observes the other resumes the coroutine.
+     */
+    std::atomic<int> phase { 0 };
+  };
+
+  /**
+   * \brief Function that starts the operation.
+   */
+  Starter _starter;
+  /**
+   * \brief State shared with the completion.
+   */
+  std::shared_ptr<State> _state;
+
+ public:
+  /**
+   * \brief Creates the awaitable.
+   *
+   * \param starter Function that starts the operation, given a callback to
+   *        complete it with.
+   */
+  explicit Awaitable(Starter starter)
+  : _starter(std::move(starter)), _state(std::make_shared<State>()) {}
+
+  /**
+   * \brief Always suspends, as the operation has not started yet.
+   */
+  bool await_ready() const noexcept {
+    return false;
+  }
+
+  /**
+   * \brief Starts the operation.
+   *
+   * \param handle Coroutine awaiting the result.
+   *
+   * \return If the coroutine remains suspended, which is \c false when the
+   *         operation completed synchronously.
+   */
+  bool await_suspend(std::coroutine_handle<> handle) {
+    _state->handle = handle;
+
+    _starter([state = _state](T result) {
+      state->result.emplace(std::move(result));
+
+      if (state->phase.exchange(1, std::memory_order_acq_rel) == 2) {
+        state->handle.resume();
+      }
+    });
+
+    return _state->phase.exchange(2, std::memory_order_acq_rel) != 1;
+  }
+
+  /**
+   * \brief Retrieves the result of the operation.
+   *
+   * \return Result of the operation.
+   */
+  T await_resume() {
+    return std::move(*_state->result);
+  }
+};
+}  // namespace discord_ipc_cpp
+
+#endif  // DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_AWAITABLE_HPP_
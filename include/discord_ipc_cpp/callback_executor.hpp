@@ -0,0 +1,374 @@
+/*
+  Copyright 2025 Peter Duanmu
+
+  You should have received a copy of the GNU General Public License along
+  with discord_ipc_cpp. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_CALLBACK_EXECUTOR_HPP_
+#define DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_CALLBACK_EXECUTOR_HPP_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * \namespace discord_ipc_cpp::executors
+ *
+ * \brief Execution of user callbacks.
+ *
+ * Contains the executors that decide where callbacks registered with the
+ * client run, so that slow callbacks never delay the receive thread.
+ */
+namespace discord_ipc_cpp::executors {
+/**
+ * \brief Callback to execute.
+ */
+using Task = std::function<void()>;
+
+/**
+ * \brief Handling of tasks submitted to a full queue.
+ */
+enum OverflowPolicy {
+  /**
+   * \brief Drops the oldest droppable task to make room.
+   */
+  op_drop_oldest,
+  /**
+   * \brief Blocks the submitter until there is room.
+   *
+   * Threads marked with a \ref NonBlockingScope, such as the client's
+   * receive thread, never block and drop the oldest droppable task instead,
+   * so heartbeats are answered no matter how slowly tasks are consumed.
+   */
+  op_block,
+  /**
+   * \brief Once the queue is full, replaces a queued task with the same
+   *        key, otherwise drops the oldest droppable task.
+   */
+  op_coalesce
+};
+
+/**
+ * \brief Marks the current thread as one that must never block on a full
+ *        queue.
+ *
+ * While a scope is alive on a thread, \ref op_block falls back to
+ * \ref op_drop_oldest for tasks that thread submits. Scopes may be nested.
+ */
+class NonBlockingScope {
+ private:
+  /**
+   * \brief If the thread was already marked before this scope.
+   */
+  bool _previous;
+
+ public:
+  /**
+   * \brief Marks the current thread.
+   */
+  NonBlockingScope();
+  /**
+   * \brief Restores the mark the thread had before this scope.
+   */
+  ~NonBlockingScope();
+
+  NonBlockingScope(const NonBlockingScope&) = delete;
+  NonBlockingScope& operator=(const NonBlockingScope&) = delete;
+
+  /**
+   * \brief Checks if the current thread is marked.
+   */
+  static bool active();
+};
+
+/**
+ * \brief Executes callbacks on behalf of the client.
+ *
+ * Every task is submitted with a key. Tasks with a key of \c 0 complete a
+ * request the caller is waiting on, and are never dropped, coalesced or
+ * blocked on. Tasks with a nonzero key, such as event handlers, may be
+ * dropped or coalesced with queued tasks of the same key under backpressure.
+ *
+ * \see discord_ipc_cpp::DiscordIPCClient::set_executor
+ */
+class CallbackExecutor {
+ public:
+  virtual ~CallbackExecutor() = default;
+
+  /**
+   * \brief Submits a task.
+   *
+   * \param task Task to execute.
+   * \param key Key of the task, or \c 0 if it must always run.
+   */
+  virtual void execute(Task task, uint64_t key) = 0;
+};
+
+/**
+ * \brief Executes tasks immediately on the submitting thread.
+ *
+ * Callbacks run on the client's receive thread, which is the lowest latency
+ * option for callbacks that return quickly.
+ */
+class InlineExecutor : public CallbackExecutor {
+ public:
+  /**
+   * \brief Runs \p task immediately.
+   */
+  void execute(Task task, uint64_t key) override;
+};
+
+/**
+ * \brief Bounded task queue with an overflow policy.
+ *
+ * Only tasks with a nonzero key count against the capacity. Tasks with a key
+ * of \c 0 complete a request someone is waiting on, so dropping them would
+ * leave the waiter hanging. They are always queued, and are bounded only by
+ * the number of requests in flight. \ref required and \ref peak_required
+ * meter them, to tell a consumer falling behind a burst of replies.
+ *
+ * \note All methods are thread-safe.
+ */
+class BoundedTaskQueue {
+ private:
+  /**
+   * \brief Queued task.
+   */
+  struct Entry {
+    /**
+     * \brief Task to execute.
+     */
+    Task task;
+    /**
+     * \brief Key of the task.
+     */
+    uint64_t key;
+  };
+
+  /**
+   * \brief Maximum number of droppable tasks queued.
+   */
+  const size_t _capacity;
+  /**
+   * \brief Handling of tasks submitted when full.
+   */
+  const OverflowPolicy _policy;
+
+  /**
+   * \brief Guards all members below.
+   */
+  mutable std::mutex _mutex;
+  /**
+   * \brief Signaled when a task is queued or the queue is closed.
+   */
+  std::condition_variable _not_empty;
+  /**
+   * \brief Signaled when a droppable task is removed or the queue is closed.
+   */
+  std::condition_variable _not_full;
+  /**
+   * \brief Queued tasks in submission order.
+   */
+  std::deque<Entry> _entries;
+  /**
+   * \brief Number of queued tasks with a nonzero key.
+   */
+  size_t _droppable;
+  /**
+   * \brief If the queue no longer accepts tasks.
+   */
+  bool _closed;
+
+  /**
+   * \brief Number of tasks dropped.
+   */
+  uint64_t _dropped;
+  /**
+   * \brief Number of tasks replaced by a newer task with the same key.
+   */
+  uint64_t _coalesced;
+  /**
+   * \brief Most tasks with a key of \c 0 ever queued at once.
+   */
+  size_t _peak_required;
+
+ private:
+  /**
+   * \brief Removes the oldest droppable task.
+   *
+   * \return If a task was removed.
+   */
+  bool drop_oldest();
+
+ public:
+  /**
+   * \brief Creates the queue.
+   *
+   * \param capacity Maximum number of droppable tasks queued.
+   * \param policy Handling of tasks submitted when full.
+   */
+  BoundedTaskQueue(size_t capacity, OverflowPolicy policy);
+
+  /**
+   * \brief Queues a task.
+   *
+   * \param task Task to execute.
+   * \param key Key of the task, or \c 0 if it must always run.
+   *
+   * \return If the task was queued, which fails once closed.
+   */
+  bool push(Task task, uint64_t key);
+  /**
+   * \brief Dequeues the oldest task.
+   *
+   * \param timeout Time to wait for a task.
+   *
+   * \return Dequeued task, or an empty task on timeout or once closed and
+   *         drained.
+   */
+  Task pop(std::chrono::milliseconds timeout);
+  /**
+   * \brief Stops accepting tasks and wakes all waiters.
+   */
+  void close();
+
+  /**
+   * \brief Checks if the queue was closed.
+   *
+   * \return If the queue no longer accepts tasks.
+   */
+  bool is_closed() const;
+  /**
+   * \brief Number of queued tasks.
+   */
+  size_t size() const;
+  /**
+   * \brief Number of tasks dropped under backpressure.
+   */
+  uint64_t dropped() const;
+  /**
+   * \brief Number of tasks replaced by a newer task with the same key.
+   */
+  uint64_t coalesced() const;
+  /**
+   * \brief Number of queued tasks with a key of \c 0, which are exempt from
+   *        the capacity.
+   */
+  size_t required() const;
+  /**
+   * \brief Most tasks with a key of \c 0 ever queued at once.
+   */
+  size_t peak_required() const;
+};
+
+/**
+ * \brief Queues tasks until the caller runs them.
+ *
+ * Lets an application run client callbacks on a thread of its own, such as a
+ * UI or game loop, by periodically calling \ref run_pending.
+ */
+class QueueExecutor : public CallbackExecutor {
+ private:
+  /**
+   * \brief Queued tasks.
+   */
+  BoundedTaskQueue _queue;
+
+ public:
+  /**
+   * \brief Creates the executor.
+   *
+   * \param capacity Maximum number of droppable tasks queued.
+   * \param policy Handling of tasks submitted when full.
+   */
+  explicit QueueExecutor(
+    size_t capacity = 256, OverflowPolicy policy = op_drop_oldest);
+
+  /**
+   * \brief Queues \p task.
+   */
+  void execute(Task task, uint64_t key) override;
+
+  /**
+   * \brief Runs queued tasks on the calling thread.
+   *
+   * \param max_tasks Maximum number of tasks to run.
+   * \param timeout Time to wait for the first task.
+   *
+   * \return Number of tasks run.
+   */
+  size_t run_pending(
+    size_t max_tasks = SIZE_MAX,
+    std::chrono::milliseconds timeout = std::chrono::milliseconds(0));
+
+  /**
+   * \brief Retrieves the underlying queue.
+   *
+   * \return Queue of tasks, for inspecting its counters.
+   */
+  const BoundedTaskQueue& queue() const;
+};
+
+/**
+ * \brief Runs tasks on a small pool of worker threads.
+ *
+ * \note With more than one worker, tasks may complete out of order.
+ */
+class ThreadPoolExecutor : public CallbackExecutor {
+ private:
+  /**
+   * \brief Queued tasks.
+   */
+  BoundedTaskQueue _queue;
+  /**
+   * \brief Worker threads.
+   */
+  std::vector<std::thread> _workers;
+
+ private:
+  /**
+   * \brief Runs tasks until the queue is closed.
+   */
+  void worker();
+
+ public:
+  /**
+   * \brief Starts the workers.
+   *
+   * \param threads Number of worker threads.
+   * \param capacity Maximum number of droppable tasks queued.
+   * \param policy Handling of tasks submitted when full.
+   */
+  explicit ThreadPoolExecutor(
+    size_t threads = 1,
+    size_t capacity = 256,
+    OverflowPolicy policy = op_drop_oldest);
+  /**
+   * \brief Runs the remaining tasks and joins the workers.
+   */
+  ~ThreadPoolExecutor() override;
+
+  ThreadPoolExecutor(const ThreadPoolExecutor&) = delete;
+  ThreadPoolExecutor& operator=(const ThreadPoolExecutor&) = delete;
+
+  /**
+   * \brief Queues \p task for a worker.
+   */
+  void execute(Task task, uint64_t key) override;
+
+  /**
+   * \brief Retrieves the underlying queue.
+   *
+   * \return Queue of tasks, for inspecting its counters.
+   */
+  const BoundedTaskQueue& queue() const;
+};
+}  // namespace discord_ipc_cpp::executors
+
+#endif  // DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_CALLBACK_EXECUTOR_HPP_
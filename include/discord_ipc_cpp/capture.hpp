@@ -0,0 +1,227 @@
+/*
+  Copyright 2025 Peter Duanmu
+
+  You should have received a copy of the GNU General Public License along
+  with discord_ipc_cpp. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_CAPTURE_HPP_
+#define DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_CAPTURE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * \namespace discord_ipc_cpp::capture
+ *
+ * \brief Recording of IPC traffic.
+ *
+ * Contains the writer appending every frame sent or received to a binary log,
+ * and the reader loading such logs for replay and analysis.
+ */
+namespace discord_ipc_cpp::capture {
+/**
+ * \brief Direction of a captured frame.
+ */
+enum Direction : uint8_t {
+  cd_outbound = 0,  ///< Sent to Discord
+  cd_inbound = 1    ///< Received from Discord
+};
+
+/**
+ * \brief Frame read from a capture.
+ */
+struct FrameRecord {
+  /**
+   * \brief Direction the frame travelled.
+   */
+  Direction direction;
+  /**
+   * \brief Time the frame was written or received, in nanoseconds since the
+   *        Unix epoch.
+   */
+  int64_t timestamp;
+  /**
+   * \brief Opcode from the frame's header.
+   */
+  int32_t opcode;
+  /**
+   * \brief Payload of the frame, pointing into the reader's mapping.
+   */
+  std::string_view payload;
+};
+
+/**
+ * \brief Appends frames to a memory-mapped ring file.
+ *
+ * The file has a fixed size chosen when opened. Once full, the oldest frames
+ * are overwritten, so capturing can be left on indefinitely. Records are
+ * copied into the mapping without any system call, and reach the file even if
+ * the process crashes.
+ *
+ * The file starts with a 64-byte header holding the magic \c DIPCCAP1, the
+ * file size, the ring's head and tail offsets and its record counts. Each
+ * record is a 24-byte header holding its padded size, the direction, the
+ * opcode, the payload length and the timestamp, followed by the payload and
+ * padded to 8 bytes. A record size of \c 0 marks where the ring wrapped.
+ * Integers are stored in the byte order of the capturing machine.
+ *
+ * \note All methods are thread-safe.
+ *
+ * \see CaptureReader
+ */
+class CaptureWriter {
+ public:
+  /**
+   * \brief Default size of a capture file.
+   */
+  static constexpr size_t default_capacity = 16 << 20;
+
+ private:
+  /**
+   * \brief Guards the mapping.
+   */
+  mutable std::mutex _mutex;
+  /**
+   * \brief Descriptor of the capture file, or \c -1 if closed.
+   */
+  int _fd;
+  /**
+   * \brief Mapping of the whole capture file.
+   */
+  char* _map;
+  /**
+   * \brief Size of the capture file.
+   */
+  size_t _size;
+
+ private:
+  /**
+   * \brief Drops the oldest record to make room.
+   */
+  void drop_oldest();
+
+ public:
+  /**
+   * \brief Creates a closed writer.
+   */
+  CaptureWriter();
+  /**
+   * \brief Flushes and closes the capture file.
+   *
+   * \see close
+   */
+  ~CaptureWriter();
+
+  CaptureWriter(const CaptureWriter&) = delete;
+  CaptureWriter& operator=(const CaptureWriter&) = delete;
+
+  /**
+   * \brief Creates or truncates a capture file and starts an empty ring.
+   *
+   * \param path Path of the capture file.
+   * \param capacity Size of the capture file in bytes.
+   *
+   * \return If the file was created and mapped.
+   */
+  bool open(const std::string& path, size_t capacity = default_capacity);
+  /**
+   * \brief Flushes the mapping to the file and closes it.
+   */
+  void close();
+  /**
+   * \brief Checks if a capture file is open.
+   */
+  bool is_open() const;
+
+  /**
+   * \brief Appends a frame, overwriting the oldest ones if the ring is full.
+   *
+   * \param direction Direction the frame travelled.
+   * \param frame Whole frame, starting with its 8-byte header.
+   * \param size Size of \p frame.
+   *
+   * \return If the frame was recorded, which fails if closed, if \p frame
+   *         is shorter than its header or if it is larger than half the ring.
+   */
+  bool record(Direction direction, const char* frame, size_t size);
+
+  /**
+   * \brief Retrieves the number of frames in the ring.
+   */
+  uint64_t records() const;
+  /**
+   * \brief Retrieves the number of frames overwritten to make room.
+   */
+  uint64_t overwritten() const;
+};
+
+/**
+ * \brief Reads a capture file.
+ *
+ * Maps the file read-only and indexes its frames from oldest to newest,
+ * without copying their payloads.
+ *
+ * \see CaptureWriter
+ */
+class CaptureReader {
+ private:
+  /**
+   * \brief Mapping of the whole capture file.
+   */
+  char* _map;
+  /**
+   * \brief Size of the capture file.
+   */
+  size_t _size;
+  /**
+   * \brief Frames from oldest to newest.
+   */
+  std::vector<FrameRecord> _frames;
+  /**
+   * \brief Number of frames overwritten while capturing.
+   */
+  uint64_t _overwritten;
+
+ public:
+  /**
+   * \brief Creates a reader without a capture.
+   */
+  CaptureReader();
+  /**
+   * \brief Unmaps the capture file.
+   */
+  ~CaptureReader();
+
+  CaptureReader(const CaptureReader&) = delete;
+  CaptureReader& operator=(const CaptureReader&) = delete;
+
+  /**
+   * \brief Maps and indexes a capture file, replacing any previous one.
+   *
+   * \param path Path of the capture file.
+   *
+   * \return If the file is a well-formed capture.
+   */
+  bool open(const std::string& path);
+  /**
+   * \brief Unmaps the capture file, invalidating \ref frames.
+   */
+  void close();
+
+  /**
+   * \brief Retrieves the frames from oldest to newest.
+   */
+  const std::vector<FrameRecord>& frames() const;
+  /**
+   * \brief Retrieves the number of frames overwritten while capturing.
+   */
+  uint64_t overwritten() const;
+};
+}  // namespace discord_ipc_cpp::capture
+
+#endif  // DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_CAPTURE_HPP_
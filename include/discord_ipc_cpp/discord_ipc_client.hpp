@@ -8,14 +8,38 @@
 #ifndef DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_DISCORD_IPC_CLIENT_HPP_
 #define DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_DISCORD_IPC_CLIENT_HPP_
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
 #include <thread>
 #include <string>
 #include <optional>
+#include <unordered_map>
+#include <utility>
+#include <variant>
 #include <vector>
 
+#include "discord_ipc_cpp/awaitable.hpp"
+#include "discord_ipc_cpp/callback_executor.hpp"
+#include "discord_ipc_cpp/capture.hpp"
 #include "discord_ipc_cpp/socket_client.hpp"
+#include "discord_ipc_cpp/transport.hpp"
 #include "discord_ipc_cpp/ipc_types.hpp"
 #include "discord_ipc_cpp/json.hpp"
+#include "discord_ipc_cpp/health_monitor.hpp"
+#include "discord_ipc_cpp/logger.hpp"
+#include "discord_ipc_cpp/metrics.hpp"
+#include "discord_ipc_cpp/mpsc_queue.hpp"
+#include "discord_ipc_cpp/presence_scheduler.hpp"
+#include "discord_ipc_cpp/presence_template.hpp"
 
 /**
  * \namespace discord_ipc_cpp
@@ -33,10 +57,183 @@ namespace discord_ipc_cpp {
  * with Discord's IPC socket. It is specially designed to handle connections
  * with the purpose of sending rich presence updates.
  *
- * \see discord_ipc_cpp::websockets::SocketClient
+ * \see discord_ipc_cpp::websockets::Transport
  */
 class DiscordIPCClient {
+ public:
+  /**
+   * \brief Callback invoked with the reply to a command.
+   */
+  using ResponseCallback = std::function<
+    void(const ipc_types::CommandResponse&)>;
+  /**
+   * \brief Callback invoked with the readiness of the connection.
+   */
+  using ReadyCallback = std::function<void(bool)>;
+  /**
+   * \brief Counters of one outbound priority lane.
+   */
+  struct LaneStats {
+    /**
+     * \brief Number of packets accepted.
+     */
+    uint64_t submitted;
+    /**
+     * \brief Number of packets written.
+     */
+    uint64_t written;
+    /**
+     * \brief Number of packets rejected for backpressure.
+     */
+    uint64_t rejected;
+    /**
+     * \brief Total size of the packets waiting to be written.
+     */
+    size_t queued_bytes;
+  };
+  /**
+   * \brief Counters of the outbound priority lanes.
+   */
+  struct OutboundStats {
+    /**
+     * \brief Lane of the handshake, pongs and closure.
+     */
+    LaneStats control;
+    /**
+     * \brief Lane of commands, such as presence updates.
+     */
+    LaneStats normal;
+  };
+  /**
+   * \brief Untyped handler invoked with the data of a dispatched event.
+   */
+  using EventHandler = std::function<void(const json::JSON&)>;
+  /**
+   * \brief Handler invoked with the previous state and the new health of the
+   *        connection when its state changes.
+   */
+  using HealthHandler = std::function<
+    void(health::HealthState, const health::HealthStatus&)>;
+
  private:
+  /**
+   * \brief Clock used for measuring round trips and timeouts.
+   */
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * \brief Queue of encoded packets of one priority.
+   *
+   * Any thread may submit packets, which are written in submission order by
+   * whichever thread holds \ref _write_mutex.
+   *
+   * \see flush_outbound
+   */
+  struct OutboundLane {
+    /**
+     * \brief Packets waiting to be written.
+     */
+    queues::MpscQueue<std::vector<char>> frames;
+    /**
+     * \brief Total size of the packets in \ref frames.
+     */
+    std::atomic<size_t> bytes { 0 };
+    /**
+     * \brief Number of packets accepted.
+     */
+    std::atomic<uint64_t> submitted { 0 };
+    /**
+     * \brief Number of packets written.
+     */
+    std::atomic<uint64_t> written { 0 };
+    /**
+     * \brief Number of packets rejected for backpressure.
+     */
+    std::atomic<uint64_t> rejected { 0 };
+
+    /**
+     * \brief Creates the lane.
+     *
+     * \param capacity Maximum number of packets waiting to be written.
+     */
+    explicit OutboundLane(size_t capacity) : frames(capacity) {}
+
+    /**
+     * \brief Snapshots the counters of the lane.
+     */
+    LaneStats stats() const;
+  };
+
+  /**
+   * \brief Presence submitted through a template.
+   */
+  struct TemplatedPresence {
+    /**
+     * \brief ID of the template.
+     */
+    uint64_t template_id;
+    /**
+     * \brief Values of the template's slots.
+     */
+    ipc_types::PresenceUpdate update;
+
+    /**
+     * \brief Compares every field.
+     */
+    bool operator==(const TemplatedPresence&) const = default;
+  };
+
+  /**
+   * \brief Presence as submitted, either in full or through a template.
+   *
+   * A full presence is empty for the empty presence.
+   */
+  using SubmittedPresence = std::variant<
+    std::optional<ipc_types::RichPresence>,
+    TemplatedPresence
+  >;
+
+  /**
+   * \brief Hashes nonces by their last 16 characters.
+   *
+   * The end of a nonce holds its random or counter bits in both
+   * \ref ipc_types::NonceMode, so hashing two words is enough to tell
+   * in-flight commands apart.
+   */
+  struct NonceHash {
+    size_t operator()(const std::string& nonce) const {
+      if (nonce.size() < 16) {
+        return std::hash<std::string>{}(nonce);
+      }
+
+      uint64_t words[2];
+
+      std::memcpy(words, nonce.data() + nonce.size() - 16, 16);
+
+      return (words[0] * 0x9e3779b97f4a7c15ULL) ^ words[1];
+    }
+  };
+
+  /**
+   * \brief A command awaiting its reply.
+   */
+  struct PendingRequest {
+    /**
+     * \brief Callback to resolve with the reply.
+     */
+    ResponseCallback callback;
+    /**
+     * \brief Time the command was sent.
+     */
+    Clock::time_point sent_at;
+    /**
+     * \brief ID of the traced request the command belongs to.
+     *
+     * \see discord_ipc_cpp::tracing::current_request
+     */
+    uint64_t trace_request;
+  };
+
   /**
    * \brief Stores the executable's process ID.
    *
@@ -52,98 +249,804 @@ class DiscordIPCClient {
   std::string _client_id;
 
   /**
-   * \brief Underlying socket connection.
+   * \brief How nonces of commands are generated.
+   */
+  std::atomic<ipc_types::NonceMode> _nonce_mode;
+  /**
+   * \brief Random upper half of nonces in \ref ipc_types::nm_counter mode.
+   */
+  const uint64_t _nonce_prefix;
+  /**
+   * \brief Lower half of the next nonce in \ref ipc_types::nm_counter mode.
+   */
+  mutable std::atomic<uint64_t> _nonce_counter;
+
+  /**
+   * \brief Encoded handshake, built once per client.
+   */
+  const std::vector<char> _handshake_frame;
+  /**
+   * \brief Encoded closure, built once per client.
+   */
+  const std::vector<char> _close_frame;
+  /**
+   * \brief Encoded empty presence with a placeholder nonce, built once per
+   *        client.
    *
-   * This is the actual class that handles connections to Discord's IPC socket.
+   * \see empty_presence_frame
+   */
+  const std::vector<char> _empty_presence_frame;
+  /**
+   * \brief Offset of the nonce in \ref _empty_presence_frame.
+   */
+  const size_t _empty_presence_nonce_offset;
+
+  /**
+   * \brief Underlying connection.
+   *
+   * This is the actual class that handles connections to Discord's IPC socket,
+   * which is a \ref discord_ipc_cpp::websockets::SocketClient unless another
+   * transport is provided on construction.
    *
-   * \see discord_ipc_cpp::websockets::SocketClient
+   * \see discord_ipc_cpp::websockets::Transport
    */
-  websockets::SocketClient _socket;
+  std::unique_ptr<websockets::Transport> _socket;
   /**
    * \brief Handles incoming packets.
    *
    * This thread handles incoming packets sent by Discord through the IPC
-   * socket.
+   * socket. It is started by the first \ref connect, serves every following
+   * connection and is joined on destruction.
    *
    * \see recv_thread
    */
   std::thread _socket_recv_thread;
+  /**
+   * \brief ID of \ref _socket_recv_thread, readable from any thread.
+   */
+  std::atomic<std::thread::id> _recv_thread_id;
 
   /**
    * \brief Controls the state of \ref _socket_recv_thread.
    *
    * When this variable is toggled from \c false to \c true,
-   * \ref _socket_recv_thread will receive the notice to terminate the \c while
-   * loop.
+   * \ref _socket_recv_thread will receive the notice to stop serving the
+   * current connection and wait for the next one.
    *
    * \see recv_thread()
    */
   std::atomic_bool _stop_recv_thread;
+  /**
+   * \brief Stage in the lifecycle of the connection.
+   *
+   * \see connection_state
+   */
+  std::atomic<ipc_types::ConnectionState> _state;
+  /**
+   * \brief Serializes \ref connect and \ref close.
+   */
+  std::mutex _lifecycle_mutex;
+  /**
+   * \brief Guards \ref _recv_active and \ref _recv_exit, and changes of
+   *        \ref _stop_recv_thread.
+   */
+  std::mutex _recv_mutex;
+  /**
+   * \brief Wakes \ref _socket_recv_thread to serve a connection or exit, and
+   *        threads waiting for it to go idle.
+   */
+  std::condition_variable _recv_cv;
+  /**
+   * \brief If \ref _socket_recv_thread is serving a connection.
+   */
+  bool _recv_active;
+  /**
+   * \brief Makes \ref _socket_recv_thread exit, set on destruction.
+   */
+  bool _recv_exit;
   /**
    * \brief Indicates successful authentication with Discord socket.
    *
-   * This variable ensures that packets are only sent after successful
-   * authentication with Discord's IPC socket. Otherwise, each \ref send_packet
-   * request will automatically return \c false.
+   * This variable is set once Discord dispatches \c READY. Until then, each
+   * \ref send_packet request outside of the control lane is held in
+   * \ref _normal_lane.
    */
   std::atomic_bool _successful_auth;
+  /**
+   * \brief Time the handshake of the current connection was sent.
+   */
+  Clock::time_point _connected_at;
+  /**
+   * \brief Guards \ref _ready_waiters and the transition of
+   *        \ref _successful_auth.
+   */
+  std::mutex _ready_mutex;
+  /**
+   * \brief Wakes threads waiting for \ref _successful_auth.
+   *
+   * \see wait_until_ready
+   */
+  std::condition_variable _ready_cv;
+  /**
+   * \brief Callbacks waiting for \c READY, with their deadlines.
+   *
+   * \see async_connect
+   */
+  std::vector<std::pair<Clock::time_point, ReadyCallback>> _ready_waiters;
+
+  /**
+   * \brief Encoded control packets: the handshake, pongs and closure.
+   *
+   * Written ahead of \ref _normal_lane, and not held until \c READY.
+   */
+  OutboundLane _control_lane;
+  /**
+   * \brief Encoded command packets, such as presence updates.
+   *
+   * Held until Discord dispatches \c READY, and capped by
+   * \ref _outbound_budget.
+   */
+  OutboundLane _normal_lane;
+  /**
+   * \brief Maximum total size of the packets in \ref _normal_lane.
+   *
+   * \see set_outbound_budget
+   */
+  std::atomic<size_t> _outbound_budget;
+  /**
+   * \brief Held by the single thread writing to the transport.
+   */
+  std::mutex _write_mutex;
+
+  /**
+   * \brief Largest payload accepted from the transport.
+   *
+   * \see set_frame_limits
+   */
+  std::atomic<size_t> _max_frame_size;
+  /**
+   * \brief Capacity of \ref _recv_buffer kept between frames.
+   *
+   * \see set_frame_limits
+   */
+  std::atomic<size_t> _max_buffered_bytes;
+  /**
+   * \brief Frame being handled by \ref _socket_recv_thread, reused across
+   *        frames and connections.
+   */
+  std::vector<char> _recv_buffer;
+
+  /**
+   * \brief Guards \ref _capture.
+   */
+  std::mutex _capture_mutex;
+  /**
+   * \brief Log every sent and received frame is recorded into, if any.
+   *
+   * \see set_capture
+   */
+  std::shared_ptr<capture::CaptureWriter> _capture;
+  /**
+   * \brief If \ref _capture is set, checked before taking its lock.
+   */
+  std::atomic_bool _capturing;
+
+  /**
+   * \brief Guards \ref _pending_requests and \ref _pending_deadlines.
+   */
+  std::mutex _pending_mutex;
+  /**
+   * \brief Commands awaiting their reply, keyed by nonce.
+   */
+  std::unordered_map<std::string, PendingRequest, NonceHash>
+    _pending_requests;
+  /**
+   * \brief Deadlines of \ref _pending_requests, earliest first.
+   *
+   * Entries whose request has already been resolved are skipped when they
+   * expire.
+   */
+  std::priority_queue<
+    std::pair<Clock::time_point, std::string>,
+    std::vector<std::pair<Clock::time_point, std::string>>,
+    std::greater<>
+  > _pending_deadlines;
+
+  /**
+   * \brief Rate limits scheduled presence updates.
+   *
+   * \see schedule_presence
+   */
+  scheduling::PresenceScheduler _presence_scheduler;
+  /**
+   * \brief Serializes releasing payloads from \ref _presence_scheduler.
+   *
+   * Ensures an older presence can never be sent after a newer one.
+   */
+  std::mutex _presence_flush_mutex;
+
+  /**
+   * \brief Guards \ref _last_presence and its sequence numbers.
+   */
+  std::mutex _presence_state_mutex;
+  /**
+   * \brief Last presence submitted on the current connection, or empty for
+   *        the empty presence.
+   */
+  SubmittedPresence _last_presence;
+  /**
+   * \brief Number of presences submitted on the current connection.
+   */
+  uint64_t _presence_sequence;
+  /**
+   * \brief Sequence number of the last presence Discord acknowledged.
+   */
+  uint64_t _acknowledged_sequence;
+
+  /**
+   * \brief Guards \ref _executor.
+   */
+  std::mutex _executor_mutex;
+  /**
+   * \brief Executor running user callbacks.
+   */
+  std::shared_ptr<executors::CallbackExecutor> _executor;
+
+  /**
+   * \brief Diagnostic logger.
+   */
+  logging::Logger _logger;
+  /**
+   * \brief Counters and latency histograms of the connection.
+   */
+  metrics::Registry _metrics;
+
+  /**
+   * \brief Guards replacing the handler lists in \ref _event_handlers.
+   */
+  std::mutex _event_mutex;
+  /**
+   * \brief Event handlers, indexed by event type.
+   *
+   * Each list is immutable once published and replaced as a whole when a
+   * handler is added, so dispatching only copies a pointer.
+   */
+  std::array<
+    std::shared_ptr<const std::vector<EventHandler>>,
+    ipc_types::event_type_count
+  > _event_handlers;
+  /**
+   * \brief Callbacks awaiting a \c SUBSCRIBE sent once the connection is
+   *        ready, indexed by event type.
+   */
+  std::array<
+    std::vector<ResponseCallback>, ipc_types::event_type_count
+  > _subscribe_acks;
+  /**
+   * \brief Bitmask of event types subscribed to on the current connection.
+   */
+  std::atomic<uint32_t> _subscribed_events;
+
+  /**
+   * \brief Decides when to probe the connection and tracks its health.
+   */
+  health::HealthMonitor _health;
+  /**
+   * \brief Guards \ref _health_handler.
+   */
+  std::mutex _health_mutex;
+  /**
+   * \brief Handler of health state changes, wrapped to run on the executor.
+   */
+  HealthHandler _health_handler;
 
  private:
   /**
-   * \brief Encodes payload into byte buffer.
+   * \brief Encodes a payload, timing the encoding.
    *
-   * Takes an input \p payload and converts it into the formatted byte buffer
-   * with the proper size that the Discord IPC socket expects.
+   * \param payload Payload to encode.
    *
-   * \param payload Data payload to encode.
+   * \return Encoded packet.
    *
-   * \return The \p payload converted into a byte buffer.
+   * \see encode_packet
    */
-  static std::vector<char> encode_packet(const ipc_types::Payload& payload);
+  std::vector<char> serialize_packet(const ipc_types::Payload& payload);
   /**
-   * \brief Receives and handles incoming packets.
+   * \brief Finds where the nonce is encoded in a packet.
+   *
+   * \param packet Encoded packet.
+   *
+   * \return Offset of the value of the nonce in \p packet.
+   */
+  static size_t find_nonce(const std::vector<char>& packet);
+  /**
+   * \brief Encodes an empty presence with a fresh nonce.
+   *
+   * Copies \ref _empty_presence_frame and writes the nonce in place, without
+   * building or serializing any JSON.
+   *
+   * \param nonce Set to the nonce of the packet.
+   *
+   * \return The encoded packet.
+   */
+  std::vector<char> empty_presence_frame(std::string* nonce) const;
+  /**
+   * \brief Generates the nonce of a command.
+   *
+   * \return A 36 character nonce, formatted as a UUID.
+   *
+   * \see set_nonce_mode
+   */
+  std::string next_nonce() const;
+  /**
+   * \brief Records frames into \ref _capture, if capturing.
    *
-   * This function is wrapped by the thread \ref _socket_recv_thread to receive
-   * incoming packets from the socket, ensuring the main thread is not blocked.
-   * The longevity of the function is controlled by the variable
-   * \ref _stop_recv_thread, which is the boolean checker within the \c while
-   * statement.
+   * \param direction Direction the frames travelled.
+   * \param frames Whole frames, starting with their headers.
+   * \param count Number of frames.
+   */
+  void capture_frames(capture::Direction direction,
+                      const std::vector<char>* frames, size_t count);
+  /**
+   * \brief Receives a whole packet without decoding it.
+   *
+   * Frames larger than \ref _max_frame_size are drained and discarded. A
+   * header with an unknown opcode or a negative length, or a discarded frame
+   * that cannot be drained in full, means the stream can no longer be
+   * followed, so the transport is closed.
+   *
+   * \param timeout Time to wait for a packet in milliseconds.
+   * \param frame Set to the packet with its header, reusing its capacity.
+   *
+   * \return If a packet was received.
+   */
+  bool recv_frame(int timeout, std::vector<char>* frame);
+  /**
+   * \brief Submits an encoded packet for sending.
+   *
+   * \param opcode Op code of the packet, which decides its lane.
+   * \param packet Encoded packet.
+   *
+   * \return Outcome of submitting the packet.
+   *
+   * \see submit_packet
+   */
+  ipc_types::SendResult submit_frame(
+    ipc_types::Opcode opcode, std::vector<char> packet);
+  /**
+   * \brief Sends an encoded command and tracks its reply.
+   *
+   * \param nonce Nonce of the command.
+   * \param packet Encoded command.
+   * \param callback Callback to invoke with the reply.
+   * \param timeout Time to wait for the reply.
+   *
+   * \see send_command
+   */
+  ipc_types::SendResult send_command_frame(
+    const std::string& nonce,
+    std::vector<char> packet,
+    ResponseCallback callback,
+    std::chrono::milliseconds timeout);
+  /**
+   * \brief Checks if a presence is already shown.
+   *
+   * Compares \p presence field by field with the last submitted presence,
+   * which must also have been acknowledged by Discord.
+   *
+   * \param presence Presence to check, or empty for the empty presence.
+   *
+   * \return If sending \p presence would change nothing.
+   */
+  bool is_current_presence(
+    const std::optional<ipc_types::RichPresence>& presence);
+  /**
+   * \brief Checks if a templated presence is already shown.
+   *
+   * \param presence Templated presence to check.
+   *
+   * \return If sending \p presence would change nothing.
+   *
+   * \see is_current_presence
+   */
+  bool is_current_presence(const TemplatedPresence& presence);
+  /**
+   * \brief Records a presence as the last submitted one.
+   *
+   * \param presence Presence being submitted.
+   *
+   * \return Sequence number of \p presence.
+   */
+  uint64_t track_presence(SubmittedPresence presence);
+  /**
+   * \brief Marks a presence as shown once Discord accepts it.
+   *
+   * \param response Reply to the presence.
+   * \param sequence Sequence number of the presence.
+   *
+   * \see track_presence
+   */
+  void acknowledge_presence(
+    const ipc_types::CommandResponse& response, uint64_t sequence);
+  /**
+   * \brief Sends a presence, tracking its acknowledgement.
+   *
+   * \param presence Presence to set, or empty for the empty presence.
+   * \param callback Callback to invoke with the reply, may be \c nullptr.
+   * \param timeout Time to wait for the reply.
+   *
+   * \return Outcome of submitting the presence.
+   */
+  ipc_types::SendResult submit_presence(
+    const std::optional<ipc_types::RichPresence>& presence,
+    ResponseCallback callback,
+    std::chrono::milliseconds timeout);
+  /**
+   * \brief Sends a templated presence, tracking its acknowledgement.
+   *
+   * \param presence_template Template to render.
+   * \param update Values of the template's slots.
+   * \param callback Callback to invoke with the reply, may be \c nullptr.
+   * \param timeout Time to wait for the reply.
+   *
+   * \return Outcome of submitting the presence.
+   */
+  ipc_types::SendResult submit_presence(
+    const ipc_types::PresenceTemplate& presence_template,
+    const ipc_types::PresenceUpdate& update,
+    ResponseCallback callback,
+    std::chrono::milliseconds timeout);
+  /**
+   * \brief Sends an encoded presence, tracking its acknowledgement.
+   *
+   * \param presence Presence being submitted.
+   * \param nonce Nonce of the command.
+   * \param packet Encoded command.
+   * \param callback Callback to invoke with the reply, may be \c nullptr.
+   * \param timeout Time to wait for the reply.
+   *
+   * \return Outcome of submitting the presence.
+   */
+  ipc_types::SendResult submit_presence_frame(
+    SubmittedPresence presence,
+    const std::string& nonce,
+    std::vector<char> packet,
+    ResponseCallback callback,
+    std::chrono::milliseconds timeout);
+  /**
+   * \brief Body of \ref _socket_recv_thread.
+   *
+   * Waits for a connection to be opened and serves it until
+   * \ref _stop_recv_thread is set, then waits for the next one, until
+   * \ref _recv_exit is set.
    */
   void recv_thread();
+  /**
+   * \brief Receives and handles incoming packets.
+   *
+   * Run by \ref _socket_recv_thread to receive incoming packets from the
+   * socket, ensuring the main thread is not blocked. The longevity of the
+   * function is controlled by the variable \ref _stop_recv_thread, which is
+   * the boolean checker within the \c while statement.
+   */
+  void serve_connection();
+  /**
+   * \brief Checks if the calling thread is \ref _socket_recv_thread.
+   */
+  bool on_recv_thread() const;
+  /**
+   * \brief Waits until \ref _socket_recv_thread is not serving a connection.
+   *
+   * \warning Must not be called from \ref _socket_recv_thread.
+   */
+  void wait_recv_idle();
+  /**
+   * \brief Closes the connection while holding \ref _lifecycle_mutex.
+   *
+   * Callbacks may connect or close again, so the pending commands and ready
+   * waiters are handed back to be resolved once \ref _lifecycle_mutex is
+   * released.
+   *
+   * \param on_receiver If called from \ref _socket_recv_thread, which then
+   *        cannot be waited for.
+   * \param pending Receives the pending commands.
+   * \param waiters Receives the waiters for the connection to be ready.
+   *
+   * \return Success of closing the transport, or \c false if not open.
+   *
+   * \see close
+   */
+  bool close_connection(
+    bool on_receiver, std::vector<PendingRequest>* pending,
+    std::vector<std::pair<Clock::time_point, ReadyCallback>>* waiters);
+
+  /**
+   * \brief Resolves a pending command.
+   *
+   * Removes the request with \p nonce from \ref _pending_requests and invokes
+   * its callback with \p response, filling in the round trip time.
+   *
+   * \param nonce Nonce of the command.
+   * \param response Reply to the command.
+   *
+   * \return If a pending command with \p nonce existed.
+   */
+  bool resolve_pending(
+    const std::string& nonce, ipc_types::CommandResponse response);
+  /**
+   * \brief Expires pending commands past their deadline.
+   *
+   * Each expired command is resolved with
+   * \ref discord_ipc_cpp::ipc_types::CommandResponse::rs_timeout.
+   *
+   * \return Time until the next deadline, capped at one second.
+   */
+  std::chrono::milliseconds expire_pending();
+  /**
+   * \brief Removes every pending command without resolving it.
+   *
+   * \return Pending commands, to be resolved with \ref fail_pending.
+   */
+  std::vector<PendingRequest> take_pending();
+  /**
+   * \brief Resolves commands taken from \ref _pending_requests.
+   *
+   * \param pending Commands to resolve.
+   * \param status Status to resolve the commands with.
+   * \param reason Reason to resolve the commands with.
+   *
+   * \warning Must not be called while holding \ref _lifecycle_mutex, as the
+   *          callbacks may connect or close.
+   */
+  void fail_pending(
+    std::vector<PendingRequest> pending,
+    ipc_types::CommandResponse::Status status, const std::string& reason);
+  /**
+   * \brief Sends the scheduled presence if the rate limit allows it.
+   *
+   * \return Time until the scheduled presence can be sent, capped at one
+   *         second.
+   */
+  std::chrono::milliseconds flush_scheduled_presence();
+  /**
+   * \brief Sends a presence released by \ref _presence_scheduler, tracking
+   *        its acknowledgement.
+   *
+   * \param payload Presence payload to send.
+   * \param sequence Sequence number the payload was scheduled with.
+   *
+   * \return Outcome of submitting the payload.
+   */
+  ipc_types::SendResult send_scheduled_presence(
+    const ipc_types::Payload& payload, uint64_t sequence);
+  /**
+   * \brief Sends a due health probe, or reconnects a dead connection.
+   *
+   * \return Time until the monitor is next due, capped at one second.
+   */
+  std::chrono::milliseconds monitor_health();
+  /**
+   * \brief Records the reply to a health probe.
+   *
+   * \param data Payload of the \c PONG, echoing the probe.
+   */
+  void acknowledge_probe(const json::JSON& data);
+  /**
+   * \brief Invokes the health handler if the state changed.
+   *
+   * \param previous State before the monitor was last updated.
+   */
+  void report_health(health::HealthState previous);
+  /**
+   * \brief Replaces a dead connection from the receive thread.
+   *
+   * Fails every pending command, drops unsent packets and forgets the
+   * presence state before reopening the transport and sending the handshake.
+   * Subscriptions are sent again once the new connection is ready.
+   *
+   * \return Success of reopening the connection.
+   */
+  bool reconnect();
+  /**
+   * \brief Reopens the connection while holding \ref _lifecycle_mutex.
+   *
+   * \param pending Receives the pending commands of the dead connection, to
+   *        be failed once \ref _lifecycle_mutex is released.
+   *
+   * \return Success of reopening the connection.
+   *
+   * \see reconnect
+   */
+  bool reopen_connection(std::vector<PendingRequest>* pending);
+  /**
+   * \brief Forgets the last presence and its acknowledgement.
+   */
+  void reset_presence_state();
+  /**
+   * \brief Marks the connection as ready.
+   *
+   * Sets \ref _successful_auth, sends every packet held in
+   * \ref _normal_lane and wakes all threads in \ref wait_until_ready.
+   */
+  void on_ready();
+  /**
+   * \brief Writes the packets in the outbound lanes to the transport.
+   *
+   * Only one thread writes at a time. If another thread is already writing,
+   * this returns immediately unless \p wait is set, and that thread writes the
+   * remaining packets. Each gathered write starts with every pending control
+   * packet, so a control packet waits for at most one write of normal packets.
+   * Normal packets are not written before the connection is ready.
+   *
+   * \param wait If the calling thread waits to become the writer.
+   *
+   * \return If no write failed.
+   */
+  bool flush_outbound(bool wait = false);
+  /**
+   * \brief Moves pending packets from a lane into a batch.
+   *
+   * \param lane Lane to take packets from.
+   * \param batch Batch to append packets to.
+   * \param limit Maximum size of \p batch.
+   *
+   * \return Total size of the packets taken.
+   */
+  static size_t drain_lane(
+    OutboundLane& lane, std::vector<std::vector<char>>* batch, size_t limit);
+  /**
+   * \brief Registers a callback for when the connection is ready.
+   *
+   * \p callback is invoked with \c true once \c READY arrives, or with
+   * \c false if the connection closes or \p timeout elapses first. It is
+   * invoked immediately if the connection is already ready.
+   *
+   * \param callback Callback to invoke.
+   * \param timeout Time to wait for \c READY.
+   */
+  void add_ready_waiter(
+    ReadyCallback callback, std::chrono::milliseconds timeout);
+  /**
+   * \brief Fails ready waiters past their deadline.
+   *
+   * \return Time until the next deadline, capped at one second.
+   */
+  std::chrono::milliseconds expire_ready_waiters();
+
+  /**
+   * \brief Retrieves the executor running user callbacks.
+   *
+   * \return Current executor.
+   */
+  std::shared_ptr<executors::CallbackExecutor> executor();
+  /**
+   * \brief Wraps a user callback to run on the executor.
+   *
+   * \param callback Callback to wrap.
+   *
+   * \return Callback that submits \p callback to the executor.
+   */
+  template<typename... Args>
+  std::function<void(Args...)> on_executor(
+    std::function<void(Args...)> callback
+  ) {
+    if (!callback) {
+      return nullptr;
+    }
+
+    return [this, callback = std::move(callback)](Args... args) {
+      executor()->execute(
+        [callback, ...args = std::decay_t<Args>(args)]() {
+          callback(args...);
+        }, 0);
+    };
+  }
+
+  /**
+   * \brief Registers an untyped event handler.
+   *
+   * Sends a \c SUBSCRIBE command for \p type if Discord requires one and it
+   * has not been sent on the current connection yet. If not connected, the
+   * subscription is sent once the connection is ready.
+   *
+   * \param type Type of the event.
+   * \param handler Handler to invoke with the event data.
+   * \param on_subscribed Callback invoked with the reply to \c SUBSCRIBE.
+   */
+  void add_event_handler(
+    ipc_types::EventType type,
+    EventHandler handler,
+    ResponseCallback on_subscribed);
+  /**
+   * \brief Checks if Discord requires a \c SUBSCRIBE command for an event.
+   *
+   * \param type Type of the event.
+   *
+   * \return If the event is only dispatched after subscribing.
+   */
+  static bool needs_subscribe(ipc_types::EventType type);
+  /**
+   * \brief Sends a \c SUBSCRIBE command once per connection.
+   *
+   * \param type Type of the event.
+   * \param on_subscribed Callback invoked with the reply, or \c nullptr.
+   *
+   * \return If the command was sent by this call.
+   */
+  bool send_subscribe(
+    ipc_types::EventType type, ResponseCallback on_subscribed);
+  /**
+   * \brief Invokes the handlers registered for an event.
+   *
+   * \param type Type of the event.
+   * \param data Data of the event.
+   */
+  void dispatch_event(ipc_types::EventType type, const json::JSON& data);
 
  protected:
+  /**
+   * \brief Encodes payload into byte buffer.
+   *
+   * Takes an input \p payload and converts it into the formatted byte buffer
+   * with the proper size that the Discord IPC socket expects.
+   *
+   * \param payload Data payload to encode.
+   *
+   * \return The \p payload converted into a byte buffer.
+   */
+  static std::vector<char> encode_packet(const ipc_types::Payload& payload);
  /**
   * \brief Sends packet to socket.
   *
   * Attempts to send a payload packet to the Discord IPC socket and indicates
-  * the success. This function is a wrapper for
-  * \ref discord_ipc_cpp::websockets::SocketClient::send_data, as it takes an
+  * the success. Packets are submitted to an outbound lane and written in
+  * order, with the handshake, pongs and closure written ahead of all other
+  * packets. Other packets sent after connecting but before Discord dispatched
+  * \c READY are held until \c READY arrives. This function is a
+  * wrapper for
+  * \ref discord_ipc_cpp::websockets::Transport::send_data, as it takes an
   * input \p payload and encodes it first with \ref encode_packet before calling
   * the underlying method.
   *
   * \param payload Payload to send.
   *
-  * \return Success of sending the packet.
+  * \return Success of sending or queueing the packet.
   *
-  * \see discord_ipc_cpp::websockets::SocketClient::send_data
+  * \see discord_ipc_cpp::websockets::Transport::send_data
   */
   bool send_packet(const ipc_types::Payload& payload);
+  /**
+   * \brief Submits a payload for sending.
+   *
+   * Same as \ref send_packet, but reports why a payload was not accepted.
+   * Payloads are rejected with \ref ipc_types::sr_backpressure while the
+   * packets waiting to be written exceed the outbound byte budget.
+   *
+   * \param payload Payload to send.
+   *
+   * \return Outcome of submitting the payload.
+   *
+   * \see set_outbound_budget
+   */
+  ipc_types::SendResult submit_packet(const ipc_types::Payload& payload);
   /**
    * \brief Receive packet from socket.
    *
    * Attempts to receive a packet from the socket using
-   * \ref discord_ipc_cpp::websockets::SocketClient::recv_data(int,int) before
+   * \ref discord_ipc_cpp::websockets::Transport::recv_data(int,int) before
    * retrieving the rest of packet with
-   * \ref discord_ipc_cpp::websockets::SocketClient::recv_data(int). The initial
+   * \ref discord_ipc_cpp::websockets::Transport::recv_data(int). The initial
    * attempt to retrieve a packet contains a timeout, after which it returns an
    * empty value.
    *
+   * \param timeout Time to wait for a packet in milliseconds.
+   *
    * \return An optional payload.
    *
-   * \see discord_ipc_cpp::websockets::SocketClient::recv_data(int)
-   * \see discord_ipc_cpp::websockets::SocketClient::recv_data(int,int)
+   * \see discord_ipc_cpp::websockets::Transport::recv_data(int)
+   * \see discord_ipc_cpp::websockets::Transport::recv_data(int,int)
    */
-  std::optional<ipc_types::Payload> recv_packet();
+  std::optional<ipc_types::Payload> recv_packet(int timeout);
 
   /**
    * \brief Constructs a presence payload.
@@ -159,32 +1062,58 @@ class DiscordIPCClient {
     const std::optional<ipc_types::RichPresence>& presence);
 
   /**
-   * \brief Attempts to send a payload.
+   * \brief Sends a command and tracks its reply.
    *
-   * Wrapping around the method \ref send_packet, this method attempts to send
-   * the \p payload \p max_retry_count times with a delay of one second between
-   * each attempt.
+   * Registers the command under the nonce of \p payload before sending it.
+   * The receive thread later resolves \p callback with Discord's reply, or
+   * with a timeout once \p timeout elapses. If the command cannot be sent,
+   * \p callback is invoked immediately.
    *
-   * \param payload Payload to attempt sending.
-   * \param max_retry_count Maximum number of times to attempt sending payload.
-   *
-   * \return Success of the attempt to send \p payload.
+   * \param payload Command payload containing a nonce.
+   * \param callback Callback to invoke with the reply.
+   * \param timeout Time to wait for the reply.
    */
-  bool attempt_send_payload(
-    const ipc_types::Payload& payload, int max_retry_count);
+  void send_command(
+    const ipc_types::Payload& payload,
+    ResponseCallback callback,
+    std::chrono::milliseconds timeout);
 
  public:
   /**
    * \brief Constructs the IPC client.
    *
    * Creates the IPC client with the \p client_id to be used when sending
-   * rich presences.
+   * rich presences, connecting through Discord's IPC socket file.
    */
   explicit DiscordIPCClient(const std::string& client_id);
+  /**
+   * \brief Constructs the IPC client over a transport.
+   *
+   * Creates the IPC client with the \p client_id to be used when sending
+   * rich presences, connecting through \p transport instead of Discord's IPC
+   * socket file.
+   *
+   * \param client_id ID of the application.
+   * \param transport Connection to communicate through.
+   *
+   * \see discord_ipc_cpp::websockets::LoopbackTransport
+   */
+  DiscordIPCClient(
+    const std::string& client_id,
+    std::unique_ptr<websockets::Transport> transport);
   /**
    * \brief Deallocates IPC client.
    *
-   * Cleans up the IPC client by releasing the underlying socket connection.
+   * Cleans up the IPC client by releasing the underlying socket connection
+   * and joining the receive thread.
+   *
+   * \warning The client must not be destroyed from one of its own callbacks
+   *          running on the receive thread, such as by resetting its owning
+   *          pointer from a handler run by an inline executor. The receive
+   *          thread would keep running on the freed client, so instead the
+   *          destructor logs an error and calls \c std::terminate. Release
+   *          the client from another thread, or run callbacks on an executor
+   *          of their own.
    *
    * \see close
    */
@@ -195,38 +1124,142 @@ class DiscordIPCClient {
    *
    * Attempts to connect to IPC socket and authorize the application. After
    * proper authorization, \ref _socket_recv_thread will be set and the
-   * application will start listening for incoming packets.
+   * application will start listening for incoming packets. A closed client
+   * may connect again, reusing its receive thread and buffers.
    *
-   * \return Success of the attempt to connect.
+   * \return Success of the attempt to connect, or \c true if already
+   *         connecting or connected.
    *
-   * \see discord_ipc_cpp::websockets::SocketClient::connect
+   * \see discord_ipc_cpp::websockets::Transport::connect
    */
   bool connect();
   /**
    * \brief Close connection to IPC socket.
    *
-   * Attempts to close the connection with the IPC socket by first sending a
-   * closure Op code and then signalling for \ref _socket_recv_thread to stop by
-   * setting \ref _stop_recv_thread to \c false. Lastly, the underlying socket
-   * is closed.
+   * Attempts to close the connection with the IPC socket by first signalling
+   * for \ref _socket_recv_thread to stop by setting \ref _stop_recv_thread to
+   * \c true and then sending a closure Op code. Once the receive thread has
+   * stopped touching the connection, the underlying socket is closed.
    *
-   * \return Success of the attempt to close connection.
+   * \return Success of the attempt to close connection, or \c false if it
+   *         was not open.
    *
-   * \see discord_ipc_cpp::websockets::SocketClient::close
+   * \see discord_ipc_cpp::websockets::Transport::close
    */
   bool close();
 
+  /**
+   * \brief Retrieves the stage in the lifecycle of the connection.
+   *
+   * \return Current stage of the connection.
+   */
+  ipc_types::ConnectionState connection_state() const;
+
+  /**
+   * \brief Waits for the connection to be ready.
+   *
+   * Blocks until Discord has dispatched \c READY after \ref connect. Packets
+   * may be sent before then, as they are held and sent once ready.
+   *
+   * \param timeout Maximum time to wait.
+   *
+   * \return If the connection is ready.
+   */
+  bool wait_until_ready(std::chrono::milliseconds timeout);
+
+  /**
+   * \brief Connects to the IPC socket without blocking on the handshake.
+   *
+   * Awaiting the result connects to the socket, sends the handshake and
+   * suspends the coroutine until Discord dispatches \c READY. The coroutine is
+   * resumed on the executor.
+   *
+   * \param timeout Time to wait for \c READY.
+   *
+   * \return Awaitable success of connecting and becoming ready.
+   *
+   * \see connect
+   */
+  Awaitable<bool> async_connect(
+    std::chrono::milliseconds timeout = std::chrono::seconds(5));
+
   /**
    * \brief Sets the presence in Discord.
    *
    * Sends a request to set the presence of the connected Discord user with
-   * \p presence.
+   * \p presence. Nothing is sent if \p presence equals the last presence
+   * Discord acknowledged on this connection.
    *
    * \param presence Presence to set.
    *
-   * \return Success of setting the presence.
+   * \return Success of sending the request.
+   *
+   * \see set_presence_async
    */
   bool set_presence(const ipc_types::RichPresence& presence);
+  /**
+   * \brief Sets the presence in Discord and awaits the reply.
+   *
+   * \param presence Presence to set.
+   * \param timeout Time to wait for Discord's reply.
+   *
+   * \return Future resolved with Discord's reply to the request.
+   */
+  std::future<ipc_types::CommandResponse> set_presence_async(
+    const ipc_types::RichPresence& presence,
+    std::chrono::milliseconds timeout = std::chrono::seconds(5));
+  /**
+   * \brief Sets the presence in Discord and reports the reply.
+   *
+   * \param presence Presence to set.
+   * \param callback Callback invoked with Discord's reply to the request, on
+   *        the executor.
+   * \param timeout Time to wait for Discord's reply.
+   */
+  void set_presence_async(
+    const ipc_types::RichPresence& presence,
+    ResponseCallback callback,
+    std::chrono::milliseconds timeout = std::chrono::seconds(5));
+  /**
+   * \brief Serializes the fixed parts of a presence for fast updates.
+   *
+   * \param base Presence whose fields other than \c details, \c state and
+   *        \c timestamps stay the same between updates.
+   *
+   * \return Template to pass to \ref set_presence along with each update.
+   */
+  ipc_types::PresenceTemplate make_presence_template(
+    const ipc_types::RichPresence& base) const;
+  /**
+   * \brief Sets a templated presence in Discord.
+   *
+   * Only escapes the fields of \p update and splices them into the
+   * pre-serialized \p presence_template. Nothing is sent if the result equals
+   * the last presence Discord acknowledged on this connection.
+   *
+   * \param presence_template Template built by \ref make_presence_template.
+   * \param update Values of the changing fields.
+   *
+   * \return Success of sending the request.
+   */
+  bool set_presence(
+    const ipc_types::PresenceTemplate& presence_template,
+    const ipc_types::PresenceUpdate& update);
+  /**
+   * \brief Sets a templated presence in Discord and awaits the reply.
+   *
+   * \param presence_template Template built by \ref make_presence_template.
+   * \param update Values of the changing fields.
+   * \param timeout Time to wait for Discord's reply.
+   *
+   * \return Future resolved with Discord's reply to the request.
+   *
+   * \see set_presence
+   */
+  std::future<ipc_types::CommandResponse> set_presence_async(
+    const ipc_types::PresenceTemplate& presence_template,
+    const ipc_types::PresenceUpdate& update,
+    std::chrono::milliseconds timeout = std::chrono::seconds(5));
   /**
    * \brief Sets an empty presence in Discord.
    *
@@ -235,6 +1268,222 @@ class DiscordIPCClient {
    * \return Success fo setting an empty presence.
    */
   bool set_empty_presence();
+  /**
+   * \brief Sets an empty presence in Discord and awaits the reply.
+   *
+   * \param timeout Time to wait for Discord's reply.
+   *
+   * \return Future resolved with Discord's reply to the request.
+   */
+  std::future<ipc_types::CommandResponse> set_empty_presence_async(
+    std::chrono::milliseconds timeout = std::chrono::seconds(5));
+
+  /**
+   * \brief Sets the presence in Discord from a coroutine.
+   *
+   * Awaiting the result sends the request and suspends the coroutine until
+   * Discord replies. The coroutine is resumed on the executor.
+   *
+   * \param presence Presence to set.
+   * \param timeout Time to wait for Discord's reply.
+   *
+   * \return Awaitable reply to the request.
+   *
+   * \see set_presence_async
+   */
+  Awaitable<ipc_types::CommandResponse> async_set_presence(
+    const ipc_types::RichPresence& presence,
+    std::chrono::milliseconds timeout = std::chrono::seconds(5));
+  /**
+   * \brief Sets an empty presence in Discord from a coroutine.
+   *
+   * \param timeout Time to wait for Discord's reply.
+   *
+   * \return Awaitable reply to the request.
+   *
+   * \see async_set_presence
+   */
+  Awaitable<ipc_types::CommandResponse> async_set_empty_presence(
+    std::chrono::milliseconds timeout = std::chrono::seconds(5));
+
+  /**
+   * \brief Schedules a presence update.
+   *
+   * Unlike \ref set_presence, this never blocks or retries. The presence is
+   * sent immediately if the rate limit allows it, and otherwise replaces any
+   * presence still waiting to be sent. The receive thread sends the newest
+   * waiting presence as soon as the rate limit allows it.
+   *
+   * \param presence Presence to set.
+   *
+   * \see set_presence_rate_limit
+   */
+  void schedule_presence(const ipc_types::RichPresence& presence);
+  /**
+   * \brief Schedules an empty presence update.
+   *
+   * \see schedule_presence
+   */
+  void schedule_empty_presence();
+  /**
+   * \brief Sets the rate limit of scheduled presence updates.
+   *
+   * Defaults to 5 updates per 20 seconds, matching Discord's limit for
+   * \c SET_ACTIVITY. The limit holds over every window of \p period, not
+   * just fixed intervals.
+   *
+   * \param burst Maximum number of updates sent within any \p period.
+   * \param period Length of the window limiting updates to \p burst.
+   */
+  void set_presence_rate_limit(
+    size_t burst, std::chrono::milliseconds period);
+
+  /**
+   * \brief Sets the outbound byte budget.
+   *
+   * Limits the total size of packets waiting to be written. Once the budget is
+   * used up, presence updates fail with backpressure instead of queueing
+   * without bound behind a slow or stalled connection. Defaults to 1 MiB.
+   *
+   * \param bytes Maximum total size of packets waiting to be written.
+   */
+  void set_outbound_budget(size_t bytes);
+  /**
+   * \brief Sets the bounds on the memory used to receive frames.
+   *
+   * Protects against corrupted or hostile frame headers. Discarded frames are
+   * logged and counted in \ref metrics::mc_oversized_frames. Defaults to 1 MiB
+   * frames and a 64 KiB receive buffer.
+   *
+   * \param limits Bounds on received frames.
+   */
+  void set_frame_limits(const ipc_types::FrameLimits& limits);
+  /**
+   * \brief Records every frame sent or received into a capture.
+   *
+   * Frames are recorded as they are written to or read from the transport,
+   * so captures can be played back with
+   * \ref discord_ipc_cpp::websockets::ReplayTransport. Capturing is off by
+   * default and costs nothing until enabled.
+   *
+   * \param capture Open capture to record into, or \c nullptr to stop.
+   */
+  void set_capture(std::shared_ptr<capture::CaptureWriter> capture);
+  /**
+   * \brief Retrieves the counters of the outbound lanes.
+   *
+   * \return Snapshot of the outbound lanes.
+   */
+  OutboundStats outbound_stats() const;
+
+  /**
+   * \brief Sets the executor running user callbacks.
+   *
+   * Event handlers, reply callbacks and coroutine resumptions run on the
+   * executor, while heartbeats are always answered by the receive thread.
+   * Defaults to an \ref discord_ipc_cpp::executors::InlineExecutor, running
+   * callbacks on the receive thread.
+   *
+   * \param executor Executor to run callbacks on.
+   *
+   * \see discord_ipc_cpp::executors::QueueExecutor
+   * \see discord_ipc_cpp::executors::ThreadPoolExecutor
+   */
+  void set_executor(std::shared_ptr<executors::CallbackExecutor> executor);
+
+  /**
+   * \brief Sets how nonces of commands are generated.
+   *
+   * Defaults to \ref ipc_types::nm_uuid. \ref ipc_types::nm_counter skips
+   * the random generator, producing increasing nonces under a random prefix
+   * that is fixed for the client, which also makes replies easy to correlate
+   * in logs and captures.
+   *
+   * \param mode How nonces are generated.
+   */
+  void set_nonce_mode(ipc_types::NonceMode mode);
+
+  /**
+   * \brief Sets how the connection is probed.
+   *
+   * Once connected, the receive thread sends a \c PING every interval and
+   * times the \c PONG. Slow or missed replies degrade the connection, and
+   * after enough missed probes in a row it is dead and reconnected. Probes
+   * are sent every 10 seconds by default.
+   *
+   * \param policy When and how the connection is probed.
+   */
+  void set_health_policy(const health::HealthPolicy& policy);
+  /**
+   * \brief Retrieves the health of the connection.
+   *
+   * \return Current state, last probe round trip and missed probes.
+   */
+  health::HealthStatus health_status() const;
+  /**
+   * \brief Sets the handler of health state changes.
+   *
+   * \param handler Handler invoked on the executor whenever the state
+   *        changes, or \c nullptr to remove it.
+   */
+  void on_health_change(HealthHandler handler);
+
+  /**
+   * \brief Retrieves the diagnostic logger.
+   *
+   * Writes warnings and errors to \c stderr by default. Lower the level to
+   * trace every received packet, or set an
+   * \ref discord_ipc_cpp::logging::AsyncRingSink to keep the receive thread
+   * from waiting on the output.
+   *
+   * \return Logger of the client.
+   */
+  logging::Logger& logger();
+
+  /**
+   * \brief Retrieves the runtime metrics of the client.
+   *
+   * Counts frames and bytes per opcode, retried, dropped and coalesced
+   * updates and reconnects, and holds histograms of serialize, parse, socket
+   * write, reply and health probe round trip times. Metrics are recorded with
+   * relaxed atomics and are never reset.
+   *
+   * \code{.cpp}
+   * auto stats = client.stats();
+   * auto p99 = stats.timers[metrics::mt_round_trip].percentile(99);
+   * \endcode
+   *
+   * \return Snapshot of the metrics.
+   */
+  metrics::Snapshot stats() const;
+
+  /**
+   * \brief Subscribes to an event.
+   *
+   * Registers \p handler to be invoked on the executor each time Discord
+   * dispatches \c Event, sending a \c SUBSCRIBE command when Discord
+   * requires one. Subscriptions made before connecting are sent once the
+   * connection is ready.
+   *
+   * \tparam Event Event struct, such as
+   *         \ref discord_ipc_cpp::ipc_types::JoinRequestEvent.
+   *
+   * \param handler Handler invoked with the typed event.
+   * \param on_subscribed Optional callback invoked with Discord's reply to the
+   *        \c SUBSCRIBE command.
+   */
+  template<typename Event>
+  void subscribe(
+    std::function<void(const Event&)> handler,
+    ResponseCallback on_subscribed = nullptr
+  ) {
+    add_event_handler(
+      Event::type,
+      [handler = std::move(handler)](const json::JSON& data) {
+        handler(Event::from_json(data));
+      },
+      std::move(on_subscribed));
+  }
 };
 }  // namespace discord_ipc_cpp
 
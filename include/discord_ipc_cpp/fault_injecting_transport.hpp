@@ -0,0 +1,303 @@
+/*
+  Copyright 2025 Peter Duanmu
+
+  You should have received a copy of the GNU General Public License along
+  with discord_ipc_cpp. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_FAULT_INJECTING_TRANSPORT_HPP_
+#define DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_FAULT_INJECTING_TRANSPORT_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+#include "discord_ipc_cpp/transport.hpp"
+
+namespace discord_ipc_cpp::websockets {
+/**
+ * \brief Faults to inject into a transport.
+ *
+ * All probabilities are in the range \c [0,1] and are evaluated once per
+ * primitive operation. The same \ref seed always produces the same sequence of
+ * faults for each direction.
+ */
+struct FaultSchedule {
+  /**
+   * \brief Seed of the fault generator.
+   */
+  uint64_t seed = 0;
+  /**
+   * \brief Probability of a receive returning fewer bytes than requested.
+   */
+  double short_read_probability = 0;
+  /**
+   * \brief Probability of a send accepting fewer bytes than given.
+   */
+  double short_write_probability = 0;
+  /**
+   * \brief Probability of an operation failing with \c EAGAIN.
+   */
+  double would_block_probability = 0;
+  /**
+   * \brief Delay added before every operation.
+   */
+  std::chrono::microseconds latency { 0 };
+  /**
+   * \brief Maximum random delay added on top of \ref latency.
+   */
+  std::chrono::microseconds latency_jitter { 0 };
+  /**
+   * \brief Maximum throughput in each direction in bytes per second.
+   *
+   * A value of \c 0 leaves the throughput uncapped.
+   */
+  size_t bandwidth = 0;
+  /**
+   * \brief Bytes to transfer on each connection before abruptly
+   *        disconnecting.
+   */
+  std::optional<size_t> disconnect_after_bytes { std::nullopt };
+  /**
+   * \brief If connecting again fails after an abrupt disconnect, instead of
+   *        opening a new connection with a fresh byte count.
+   */
+  bool permanent_disconnect = false;
+};
+
+/**
+ * \brief Counts of the faults injected so far.
+ */
+struct FaultStats {
+  /**
+   * \brief Number of shortened receives.
+   */
+  uint64_t short_reads;
+  /**
+   * \brief Number of shortened sends.
+   */
+  uint64_t short_writes;
+  /**
+   * \brief Number of operations failed with \c EAGAIN.
+   */
+  uint64_t would_blocks;
+  /**
+   * \brief Total time spent in injected delays and bandwidth throttling.
+   */
+  std::chrono::microseconds delayed;
+  /**
+   * \brief Total bytes passed through in both directions.
+   */
+  uint64_t bytes;
+  /**
+   * \brief If the current connection was abruptly disconnected.
+   */
+  bool disconnected;
+  /**
+   * \brief Number of abrupt disconnects injected.
+   */
+  uint64_t disconnects;
+};
+
+/**
+ * \brief Transport decorator that injects faults.
+ *
+ * Wraps another transport and disturbs its primitive operations according to a
+ * \ref FaultSchedule, emulating a slow, congested or failing peer. Used to
+ * measure how the client degrades under backpressure and to verify that the
+ * framing layer copes with partial I/O.
+ *
+ * \see discord_ipc_cpp::websockets::Transport
+ */
+class FaultInjectingTransport : public Transport {
+ private:
+  /**
+   * \brief Per-direction fault generator state.
+   */
+  struct Direction {
+    /**
+     * \brief Guards the generator state.
+     */
+    std::mutex mutex;
+    /**
+     * \brief State of the xorshift generator.
+     */
+    uint64_t state;
+    /**
+     * \brief Earliest time the next transfer may start under the bandwidth
+     *        cap.
+     */
+    std::chrono::steady_clock::time_point next_transfer;
+  };
+
+  /**
+   * \brief Wrapped transport.
+   */
+  std::unique_ptr<Transport> _inner;
+  /**
+   * \brief Faults to inject.
+   */
+  const FaultSchedule _schedule;
+
+  /**
+   * \brief Fault generator for sends.
+   */
+  Direction _send;
+  /**
+   * \brief Fault generator for receives.
+   */
+  Direction _recv;
+
+  /**
+   * \brief Number of shortened receives.
+   */
+  std::atomic<uint64_t> _short_reads;
+  /**
+   * \brief Number of shortened sends.
+   */
+  std::atomic<uint64_t> _short_writes;
+  /**
+   * \brief Number of operations failed with \c EAGAIN.
+   */
+  std::atomic<uint64_t> _would_blocks;
+  /**
+   * \brief Total injected delay in microseconds.
+   */
+  std::atomic<int64_t> _delayed_us;
+  /**
+   * \brief Total bytes transferred in both directions.
+   */
+  std::atomic<uint64_t> _bytes;
+  /**
+   * \brief Bytes transferred in both directions on the current connection.
+   */
+  std::atomic<uint64_t> _connection_bytes;
+  /**
+   * \brief If the current connection was abruptly disconnected.
+   */
+  std::atomic_bool _disconnected;
+  /**
+   * \brief Number of abrupt disconnects injected.
+   */
+  std::atomic<uint64_t> _disconnects;
+
+ private:
+  /**
+   * \brief Draws a uniform number in \c [0,1) from \p direction.
+   */
+  static double next_uniform(Direction& direction);
+
+  /**
+   * \brief Applies latency and bandwidth throttling before an operation.
+   *
+   * \param direction Direction of the operation.
+   *
+   * \return If the operation should fail with \c EAGAIN.
+   */
+  bool before_operation(Direction& direction);
+  /**
+   * \brief Picks the number of bytes to transfer.
+   *
+   * \param direction Direction of the operation.
+   * \param size Requested number of bytes.
+   * \param probability Probability of shortening the transfer.
+   * \param counter Counter to increment when shortening.
+   *
+   * \return Number of bytes to transfer.
+   */
+  size_t pick_size(Direction& direction, size_t size, double probability,
+                   std::atomic<uint64_t>& counter);
+  /**
+   * \brief Accounts for transferred bytes.
+   *
+   * Updates the bandwidth schedule and disconnects once the byte limit of the
+   * schedule has been reached.
+   *
+   * \param direction Direction of the operation.
+   * \param size Number of bytes transferred.
+   */
+  void after_operation(Direction& direction, size_t size);
+
+ public:
+  /**
+   * \brief Wraps a transport.
+   *
+   * \param inner Transport to inject faults into.
+   * \param schedule Faults to inject.
+   */
+  FaultInjectingTransport(
+    std::unique_ptr<Transport> inner, const FaultSchedule& schedule);
+
+  /**
+   * \brief Retrieves the injected fault counts.
+   *
+   * \return Snapshot of the injected faults.
+   */
+  FaultStats stats() const;
+
+  /**
+   * \brief Connects the wrapped transport.
+   *
+   * Clears an injected disconnect and restarts the byte count towards the
+   * next one, unless the schedule makes disconnects permanent.
+   *
+   * \return Success of connecting, which always fails after a permanent
+   *         disconnect.
+   */
+  bool connect() override;
+  /**
+   * \brief Closes the wrapped transport.
+   *
+   * \return Success of closing the wrapped transport.
+   */
+  bool close() override;
+  /**
+   * \brief Checks if the wrapped transport is connected.
+   *
+   * \return If the wrapped transport is connected and no disconnect has been
+   *         injected.
+   */
+  bool is_connected() const override;
+  /**
+   * \brief Interrupts the wrapped transport.
+   */
+  void interrupt() override;
+
+  /**
+   * \brief Waits for the wrapped transport to have data available.
+   *
+   * \param timeout Time to wait in milliseconds.
+   *
+   * \return If data or an injected disconnect can be read.
+   */
+  bool wait_readable(int timeout) override;
+  /**
+   * \brief Waits for the wrapped transport to accept more data.
+   *
+   * \param timeout Time to wait in milliseconds.
+   *
+   * \return If data can be sent.
+   */
+  bool wait_writable(int timeout) override;
+
+  /**
+   * \brief Sends part of a buffer through the wrapped transport.
+   *
+   * May delay, shorten or fail with \c EAGAIN according to the schedule. Fails
+   * with \c ECONNRESET once disconnected.
+   */
+  ssize_t send_some(const char* data, size_t size) override;
+  /**
+   * \brief Receives part of a buffer from the wrapped transport.
+   *
+   * May delay, shorten or fail with \c EAGAIN according to the schedule.
+   * Reports a closed connection once disconnected.
+   */
+  ssize_t recv_some(char* buffer, size_t size) override;
+};
+}  // namespace discord_ipc_cpp::websockets
+
+#endif  // DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_FAULT_INJECTING_TRANSPORT_HPP_
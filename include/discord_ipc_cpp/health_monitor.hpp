@@ -0,0 +1,208 @@
+/*
+  Copyright 2025 Peter Duanmu
+
+  You should have received a copy of the GNU General Public License along
+  with discord_ipc_cpp. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_HEALTH_MONITOR_HPP_
+#define DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_HEALTH_MONITOR_HPP_
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+
+/**
+ * \namespace discord_ipc_cpp::health
+ *
+ * \brief Connection liveness.
+ *
+ * Contains the monitor deciding when to probe the connection with heartbeats
+ * and how healthy it is from their round trips.
+ */
+namespace discord_ipc_cpp::health {
+/**
+ * \brief Health of a connection.
+ */
+enum HealthState : int {
+  hs_healthy = 0,   ///< Probes are answered in time
+  hs_degraded = 1,  ///< Probes are answered slowly or were missed
+  hs_dead = 2       ///< Too many probes in a row were missed
+};
+
+/**
+ * \brief When and how the connection is probed.
+ */
+struct HealthPolicy {
+  /**
+   * \brief Time between probes. A zero interval disables probing.
+   */
+  std::chrono::milliseconds interval { std::chrono::seconds(10) };
+  /**
+   * \brief Time to wait for a probe's reply before counting it as missed.
+   */
+  std::chrono::milliseconds timeout { std::chrono::seconds(5) };
+  /**
+   * \brief Round trip above which the connection is degraded.
+   */
+  std::chrono::milliseconds degraded_round_trip { 500 };
+  /**
+   * \brief Number of probes missed in a row after which the connection is
+   *        dead.
+   */
+  uint32_t dead_after { 3 };
+  /**
+   * \brief If a dead connection is reconnected, retried every
+   *        \ref interval.
+   */
+  bool reconnect { true };
+};
+
+/**
+ * \brief Health of a connection at a point in time.
+ */
+struct HealthStatus {
+  /**
+   * \brief Current state.
+   */
+  HealthState state;
+  /**
+   * \brief Round trip of the last answered probe, or zero if none was.
+   */
+  std::chrono::nanoseconds round_trip;
+  /**
+   * \brief Number of probes missed since the last answered one.
+   */
+  uint32_t missed_probes;
+};
+
+/**
+ * \brief Heartbeat scheduler and health state machine.
+ *
+ * Holds at most one outstanding probe. The owner sends a probe whenever
+ * \ref poll returns one and reports its reply through \ref acknowledge. The
+ * monitor never performs I/O itself.
+ *
+ * \note All methods are thread-safe.
+ */
+class HealthMonitor {
+ public:
+  /**
+   * \brief Clock used for scheduling probes.
+   */
+  using Clock = std::chrono::steady_clock;
+
+ private:
+  /**
+   * \brief Guards all members.
+   */
+  mutable std::mutex _mutex;
+  /**
+   * \brief When and how the connection is probed.
+   */
+  HealthPolicy _policy;
+  /**
+   * \brief Current health.
+   */
+  HealthStatus _status;
+  /**
+   * \brief ID of the probe awaiting its reply, or \c 0 if none is.
+   */
+  uint64_t _outstanding;
+  /**
+   * \brief ID of the last probe sent.
+   */
+  uint64_t _last_probe;
+  /**
+   * \brief Time the outstanding probe was sent.
+   */
+  Clock::time_point _sent_at;
+  /**
+   * \brief Time the next probe, or reconnection attempt when dead, is due.
+   */
+  Clock::time_point _next_due;
+
+ private:
+  /**
+   * \brief Derives the state from the last round trip and missed probes.
+   */
+  void update_state();
+
+ public:
+  /**
+   * \brief Creates a healthy monitor.
+   *
+   * \param policy When and how the connection is probed.
+   */
+  explicit HealthMonitor(const HealthPolicy& policy);
+
+  /**
+   * \brief Replaces the policy, taking effect from the next probe.
+   *
+   * \param policy When and how the connection is probed.
+   */
+  void set_policy(const HealthPolicy& policy);
+  /**
+   * \brief Retrieves the policy.
+   */
+  HealthPolicy policy() const;
+
+  /**
+   * \brief Starts monitoring a new connection as healthy.
+   *
+   * \param now Time the connection was opened.
+   */
+  void reset(Clock::time_point now);
+  /**
+   * \brief Marks the connection as dead, such as when the peer closed it.
+   *
+   * \param now Current time.
+   */
+  void fail(Clock::time_point now);
+
+  /**
+   * \brief Expires the outstanding probe and issues the next one when due.
+   *
+   * \param now Current time.
+   *
+   * \return ID of a probe to send now, if any.
+   */
+  std::optional<uint64_t> poll(Clock::time_point now);
+  /**
+   * \brief Records the reply to a probe.
+   *
+   * \param probe ID of the answered probe.
+   * \param now Time the reply was received.
+   *
+   * \return Round trip of the probe, or empty if \p probe is not outstanding.
+   */
+  std::optional<Clock::duration> acknowledge(
+    uint64_t probe, Clock::time_point now);
+  /**
+   * \brief Checks if a dead connection should be reconnected now.
+   *
+   * Schedules the next attempt one interval later when returning \c true.
+   *
+   * \param now Current time.
+   *
+   * \return If the connection is dead and an attempt is due.
+   */
+  bool should_reconnect(Clock::time_point now);
+
+  /**
+   * \brief Time until \ref poll or \ref should_reconnect has work to do.
+   *
+   * \param now Current time.
+   *
+   * \return Empty if probing is disabled.
+   */
+  std::optional<Clock::duration> next_due(Clock::time_point now) const;
+  /**
+   * \brief Retrieves the current health.
+   */
+  HealthStatus status() const;
+};
+}  // namespace discord_ipc_cpp::health
+
+#endif  // DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_HEALTH_MONITOR_HPP_
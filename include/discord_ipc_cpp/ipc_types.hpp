@@ -8,6 +8,9 @@
 #ifndef DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_IPC_TYPES_HPP_
 #define DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_IPC_TYPES_HPP_
 
+#include <chrono>
+#include <cstddef>
+#include <functional>
 #include <optional>
 #include <string>
 #include <vector>
@@ -34,6 +37,22 @@ enum Opcode : int {
   op_pong = 4        ///< Heartbeat response from ping
 };
 
+/**
+ * \brief Events dispatched by the socket.
+ */
+enum EventType : int {
+  et_error = 0,         ///< An error occurred
+  et_join = 1,          ///< User joined a party through the presence
+  et_join_request = 2,  ///< User requested to join the presence's party
+  et_ready = 3,         ///< Handshake completed
+  et_spectate = 4       ///< User started spectating through the presence
+};
+
+/**
+ * \brief Number of values in \ref EventType.
+ */
+inline constexpr size_t event_type_count = 5;
+
 /**
  * \brief Represents a data payload.
  *
@@ -51,6 +70,268 @@ struct Payload {
   const json::JSON payload;
 };
 
+/**
+ * \brief Outcome of submitting a payload for sending.
+ */
+enum SendResult : int {
+  sr_accepted = 0,      ///< Submitted for writing on a ready connection
+  sr_held = 1,          ///< Held until Discord dispatches \c READY
+  sr_backpressure = 2,  ///< Rejected as the outbound byte budget is used up
+  sr_closed = 3         ///< Not connected, or writing failed
+};
+
+/**
+ * \brief How nonces of commands are generated.
+ */
+enum NonceMode : int {
+  nm_uuid = 0,    ///< Random version 4 UUID per command
+  nm_counter = 1  ///< Random per-client prefix followed by a counter
+};
+
+/**
+ * \brief Stage in the lifecycle of a connection.
+ */
+enum ConnectionState : int {
+  cs_idle = 0,        ///< Never connected
+  cs_connecting = 1,  ///< Handshake sent, waiting for \c READY
+  cs_ready = 2,       ///< Discord dispatched \c READY
+  cs_closing = 3,     ///< Closure in progress
+  cs_closed = 4       ///< Closed, and may connect again
+};
+
+/**
+ * \brief Bounds on the memory used to receive frames.
+ *
+ * A connection holds at most one received frame at a time, so its receive
+ * memory is bounded by \ref max_frame_size. The memory used by frames waiting
+ * to be sent is bounded separately by the outbound budget.
+ */
+struct FrameLimits {
+  /**
+   * \brief Largest payload accepted, in bytes.
+   *
+   * Larger frames are read in fixed chunks and discarded without being
+   * buffered.
+   */
+  size_t max_frame_size { 1 << 20 };
+  /**
+   * \brief Receive buffer capacity kept by a connection between frames, in
+   *        bytes.
+   *
+   * A buffer grown past it by a large frame is released once the frame has
+   * been handled.
+   */
+  size_t max_buffered_bytes { 1 << 16 };
+};
+
+/**
+ * \brief Reply to a command sent to the socket.
+ *
+ * Carries the outcome of a command, matched to the request by its nonce.
+ */
+struct CommandResponse {
+  /**
+   * \brief Outcome of the command.
+   */
+  enum Status : int {
+    rs_success = 0,      ///< Discord acknowledged the command
+    rs_error = 1,        ///< Discord rejected the command
+    rs_timeout = 2,      ///< No reply arrived in time
+    rs_closed = 3,       ///< The command was not sent or the connection closed
+    rs_backpressure = 4  ///< The outbound byte budget was used up
+  };
+
+  /**
+   * \brief Outcome of the command.
+   */
+  Status status;
+  /**
+   * \brief Data of the reply, if any.
+   */
+  std::optional<json::JSON> data { std::nullopt };
+  /**
+   * \brief Error code reported by Discord when \ref status is \ref rs_error.
+   */
+  std::optional<int> error_code { std::nullopt };
+  /**
+   * \brief Human readable reason for a non-successful \ref status.
+   */
+  std::string error_message {};
+  /**
+   * \brief Time between sending the command and receiving its reply.
+   */
+  std::chrono::nanoseconds round_trip { 0 };
+};
+
+/**
+ * \brief A Discord user.
+ */
+struct User {
+  /**
+   * \brief ID of the user.
+   */
+  std::string id;
+  /**
+   * \brief Username of the user.
+   */
+  std::string username;
+  /**
+   * \brief Legacy discriminator of the user.
+   */
+  std::optional<std::string> discriminator { std::nullopt };
+  /**
+   * \brief Display name of the user.
+   */
+  std::optional<std::string> global_name { std::nullopt };
+  /**
+   * \brief Avatar hash of the user.
+   */
+  std::optional<std::string> avatar { std::nullopt };
+
+ public:
+  /**
+   * \brief Converts a JSON into the struct.
+   *
+   * \param data JSON representation of the user.
+   *
+   * \return The user, with missing fields left empty.
+   */
+  static User from_json(const json::JSON& data);
+};
+
+/**
+ * \brief Dispatched once the handshake completes.
+ */
+struct ReadyEvent {
+  /**
+   * \brief Type of the event.
+   */
+  static constexpr EventType type = et_ready;
+
+  /**
+   * \brief Version of the IPC protocol.
+   */
+  std::optional<int> version { std::nullopt };
+  /**
+   * \brief User logged into Discord.
+   */
+  std::optional<User> user { std::nullopt };
+
+ public:
+  /**
+   * \brief Converts event data into the struct.
+   *
+   * \param data Data of the event.
+   *
+   * \return The event.
+   */
+  static ReadyEvent from_json(const json::JSON& data);
+};
+
+/**
+ * \brief Dispatched when an error occurs outside of a command.
+ */
+struct ErrorEvent {
+  /**
+   * \brief Type of the event.
+   */
+  static constexpr EventType type = et_error;
+
+  /**
+   * \brief Error code.
+   */
+  int code {};
+  /**
+   * \brief Description of the error.
+   */
+  std::string message {};
+
+ public:
+  /**
+   * \brief Converts event data into the struct.
+   *
+   * \param data Data of the event.
+   *
+   * \return The event.
+   */
+  static ErrorEvent from_json(const json::JSON& data);
+};
+
+/**
+ * \brief Dispatched when the user joins a party through a presence.
+ */
+struct JoinEvent {
+  /**
+   * \brief Type of the event.
+   */
+  static constexpr EventType type = et_join;
+
+  /**
+   * \brief Join secret of the presence.
+   */
+  std::string secret {};
+
+ public:
+  /**
+   * \brief Converts event data into the struct.
+   *
+   * \param data Data of the event.
+   *
+   * \return The event.
+   */
+  static JoinEvent from_json(const json::JSON& data);
+};
+
+/**
+ * \brief Dispatched when the user spectates through a presence.
+ */
+struct SpectateEvent {
+  /**
+   * \brief Type of the event.
+   */
+  static constexpr EventType type = et_spectate;
+
+  /**
+   * \brief Spectate secret of the presence.
+   */
+  std::string secret {};
+
+ public:
+  /**
+   * \brief Converts event data into the struct.
+   *
+   * \param data Data of the event.
+   *
+   * \return The event.
+   */
+  static SpectateEvent from_json(const json::JSON& data);
+};
+
+/**
+ * \brief Dispatched when another user asks to join the presence's party.
+ */
+struct JoinRequestEvent {
+  /**
+   * \brief Type of the event.
+   */
+  static constexpr EventType type = et_join_request;
+
+  /**
+   * \brief User requesting to join.
+   */
+  User user {};
+
+ public:
+  /**
+   * \brief Converts event data into the struct.
+   *
+   * \param data Data of the event.
+   *
+   * \return The event.
+   */
+  static JoinRequestEvent from_json(const json::JSON& data);
+};
+
 /**
  * \brief A Discord rich presence.
  *
@@ -76,6 +357,11 @@ struct RichPresence {
      */
     std::optional<int> end;
 
+    /**
+     * \brief Compares every field.
+     */
+    bool operator==(const Timestamps&) const = default;
+
    private:
     /**
      * \brief Converts the struct into a JSON.
@@ -106,6 +392,11 @@ struct RichPresence {
      */
     std::optional<bool> animated;
 
+    /**
+     * \brief Compares every field.
+     */
+    bool operator==(const ActivityEmoji&) const = default;
+
    private:
     /**
      * \brief Converts the struct into a JSON.
@@ -135,6 +426,11 @@ struct RichPresence {
      */
     std::optional<std::vector<int>> size;
 
+    /**
+     * \brief Compares every field.
+     */
+    bool operator==(const Party&) const = default;
+
    private:
     /**
      * \brief Converts the struct into a JSON.
@@ -177,6 +473,11 @@ struct RichPresence {
      */
     std::optional<std::string> small_url;
 
+    /**
+     * \brief Compares every field.
+     */
+    bool operator==(const Assets&) const = default;
+
    private:
     /**
      * \brief Converts the struct into a JSON.
@@ -207,6 +508,11 @@ struct RichPresence {
      */
     std::optional<std::string> spectate;
 
+    /**
+     * \brief Compares every field.
+     */
+    bool operator==(const Secrets&) const = default;
+
    private:
     /**
      * \brief Converts the struct into a JSON.
@@ -235,6 +541,11 @@ struct RichPresence {
      */
     std::string url;
 
+    /**
+     * \brief Compares every field.
+     */
+    bool operator==(const Button&) const = default;
+
    private:
     /**
      * \brief Converts the struct into a JSON.
@@ -364,7 +675,37 @@ struct RichPresence {
    * \see discord_ipc_cpp::json::JSON
    */
   json::JSON to_json() const;
+
+  /**
+   * \brief Compares every field, including nested structs.
+   *
+   * Runs in time linear to the number of fields, without serializing.
+   */
+  bool operator==(const RichPresence&) const = default;
+
+  /**
+   * \brief Hashes every field, including nested structs.
+   *
+   * Equal presences hash equally.
+   *
+   * \return Hash of the presence.
+   */
+  size_t hash() const;
 };
 }  // namespace discord_ipc_cpp::ipc_types
 
+/**
+ * \brief Hashes a rich presence.
+ *
+ * \see discord_ipc_cpp::ipc_types::RichPresence::hash
+ */
+template<>
+struct std::hash<discord_ipc_cpp::ipc_types::RichPresence> {
+  size_t operator()(
+    const discord_ipc_cpp::ipc_types::RichPresence& presence
+  ) const {
+    return presence.hash();
+  }
+};
+
 #endif  // DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_IPC_TYPES_HPP_
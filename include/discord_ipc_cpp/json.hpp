@@ -8,6 +8,8 @@
 #ifndef DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_JSON_HPP_
 #define DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_JSON_HPP_
 
+#include <cstddef>
+#include <functional>
 #include <map>
 #include <string>
 #include <sstream>
@@ -296,7 +298,42 @@ class JSON {
    * into the proper JSON format.
    */
   std::string to_string() const;
+
+  /**
+   * \brief Compares JSON items structurally.
+   *
+   * Two items are equal if they hold the same type and value, with objects
+   * and arrays compared item by item. Numbers of different types, such as
+   * \c 1 and \c 1.0, are not equal.
+   *
+   * \param other Item to compare with.
+   *
+   * \return If both items are equal.
+   */
+  bool operator==(const JSON& other) const;
+
+  /**
+   * \brief Hashes the JSON item structurally.
+   *
+   * Walks the item and its nested items without stringifying them, so that
+   * equal items hash equally.
+   *
+   * \return Hash of the JSON item.
+   */
+  size_t hash() const;
 };
 }  // namespace discord_ipc_cpp::json
 
+/**
+ * \brief Hashes a JSON item.
+ *
+ * \see discord_ipc_cpp::json::JSON::hash
+ */
+template<>
+struct std::hash<discord_ipc_cpp::json::JSON> {
+  size_t operator()(const discord_ipc_cpp::json::JSON& json) const {
+    return json.hash();
+  }
+};
+
 #endif  // DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_JSON_HPP_
@@ -0,0 +1,271 @@
+/*
+  Copyright 2025 Peter Duanmu
+
+  You should have received a copy of the GNU General Public License along
+  with discord_ipc_cpp. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_LOGGER_HPP_
+#define DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_LOGGER_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+#include "discord_ipc_cpp/mpsc_queue.hpp"
+
+/**
+ * \brief Lowest log level compiled into the library.
+ *
+ * Messages below this level are removed at compile time, including the
+ * formatting of their arguments. Defaults to \c 0, which keeps all levels.
+ *
+ * \see discord_ipc_cpp::logging::LogLevel
+ */
+#ifndef DISCORD_IPC_CPP_LOG_LEVEL
+#define DISCORD_IPC_CPP_LOG_LEVEL 0
+#endif
+
+/**
+ * \namespace discord_ipc_cpp::logging
+ *
+ * \brief Diagnostic logging.
+ *
+ * Contains the level-filtered logger used by the client and the sinks that
+ * messages can be written to.
+ */
+namespace discord_ipc_cpp::logging {
+/**
+ * \brief Severity of a log message.
+ */
+enum LogLevel : int {
+  ll_trace = 0,    ///< Every frame sent and received
+  ll_debug = 1,    ///< Internal state changes
+  ll_info = 2,     ///< Connection lifecycle
+  ll_warning = 3,  ///< Recoverable failures
+  ll_error = 4,    ///< Unrecoverable failures
+  ll_off = 5       ///< Disables logging
+};
+
+/**
+ * \brief Retrieves the name of a log level.
+ *
+ * \param level Level to name.
+ *
+ * \return Upper case name of \p level.
+ */
+std::string_view level_name(LogLevel level);
+
+/**
+ * \brief Destination of log messages.
+ */
+class LogSink {
+ public:
+  virtual ~LogSink() = default;
+
+  /**
+   * \brief Writes a message.
+   *
+   * \param level Severity of the message.
+   * \param message Formatted message.
+   */
+  virtual void write(LogLevel level, std::string_view message) = 0;
+};
+
+/**
+ * \brief Writes messages synchronously to \c stderr.
+ */
+class StderrSink : public LogSink {
+ private:
+  /**
+   * \brief Keeps lines from different threads apart.
+   */
+  std::mutex _mutex;
+
+ public:
+  /**
+   * \brief Writes \p message as a single line.
+   */
+  void write(LogLevel level, std::string_view message) override;
+};
+
+/**
+ * \brief Hands messages to a background thread through a lock-free ring.
+ *
+ * Writing only moves the message into a bounded queue, so a logging thread
+ * never waits on the downstream sink. When the ring is full, messages are
+ * dropped and counted instead of blocking.
+ */
+class AsyncRingSink : public LogSink {
+ private:
+  /**
+   * \brief Queued message.
+   */
+  struct Record {
+    /**
+     * \brief Severity of the message.
+     */
+    LogLevel level;
+    /**
+     * \brief Formatted message.
+     */
+    std::string message;
+  };
+
+  /**
+   * \brief Sink written to from the background thread.
+   */
+  std::shared_ptr<LogSink> _downstream;
+  /**
+   * \brief Messages waiting to be written.
+   */
+  queues::MpscQueue<Record> _records;
+  /**
+   * \brief Serializes popping from \ref _records.
+   */
+  std::mutex _drain_mutex;
+  /**
+   * \brief Number of messages dropped as the ring was full.
+   */
+  std::atomic<uint64_t> _dropped;
+  /**
+   * \brief Stops the background thread.
+   */
+  std::atomic_bool _stop;
+  /**
+   * \brief Background thread writing to \ref _downstream.
+   */
+  std::thread _worker;
+
+ private:
+  /**
+   * \brief Writes queued messages until stopped.
+   */
+  void run();
+
+ public:
+  /**
+   * \brief Starts the background thread.
+   *
+   * \param downstream Sink to write messages to.
+   * \param capacity Maximum number of queued messages.
+   */
+  explicit AsyncRingSink(
+    std::shared_ptr<LogSink> downstream, size_t capacity = 1024);
+  /**
+   * \brief Writes the remaining messages and stops the background thread.
+   */
+  ~AsyncRingSink() override;
+
+  AsyncRingSink(const AsyncRingSink&) = delete;
+  AsyncRingSink& operator=(const AsyncRingSink&) = delete;
+
+  /**
+   * \brief Queues \p message without blocking.
+   */
+  void write(LogLevel level, std::string_view message) override;
+  /**
+   * \brief Writes every queued message on the calling thread.
+   */
+  void flush();
+
+  /**
+   * \brief Number of messages dropped as the ring was full.
+   */
+  uint64_t dropped() const;
+};
+
+/**
+ * \brief Level-filtered logger.
+ *
+ * Messages are produced lazily by a callable, which is only invoked when the
+ * level is enabled both at compile time and at runtime. A disabled message
+ * costs a single relaxed atomic load, or nothing when below
+ * \ref DISCORD_IPC_CPP_LOG_LEVEL.
+ *
+ * \code{.cpp}
+ * logger.log<ll_debug>([&]() {
+ *   return "expired " + std::to_string(count) + " requests";
+ * });
+ * \endcode
+ */
+class Logger {
+ private:
+  /**
+   * \brief Lowest level written.
+   */
+  std::atomic<int> _level;
+  /**
+   * \brief Guards \ref _sink.
+   */
+  mutable std::mutex _sink_mutex;
+  /**
+   * \brief Destination of messages.
+   */
+  std::shared_ptr<LogSink> _sink;
+
+  /**
+   * \brief Writes a formatted message to the sink.
+   */
+  void write(LogLevel level, std::string_view message);
+
+ public:
+  /**
+   * \brief Creates the logger.
+   *
+   * \param level Lowest level written.
+   * \param sink Destination of messages, or \c nullptr for \c stderr.
+   */
+  explicit Logger(
+    LogLevel level = ll_warning, std::shared_ptr<LogSink> sink = nullptr);
+
+  /**
+   * \brief Sets the lowest level written.
+   *
+   * \param level Lowest level written, or \ref ll_off to disable logging.
+   */
+  void set_level(LogLevel level);
+  /**
+   * \brief Sets the destination of messages.
+   *
+   * \param sink Destination of messages, or \c nullptr for \c stderr.
+   */
+  void set_sink(std::shared_ptr<LogSink> sink);
+
+  /**
+   * \brief Checks if a level is written.
+   *
+   * \param level Level to check.
+   *
+   * \return If messages at \p level are written.
+   */
+  bool enabled(LogLevel level) const {
+    return level >= DISCORD_IPC_CPP_LOG_LEVEL &&
+           level >= _level.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * \brief Logs a lazily formatted message.
+   *
+   * \tparam level Severity of the message.
+   *
+   * \param format Callable returning the message, only invoked if \p level is
+   *        enabled.
+   */
+  template<LogLevel level, typename Format>
+  void log(Format&& format) {
+    if constexpr (level >= DISCORD_IPC_CPP_LOG_LEVEL) {
+      if (enabled(level)) {
+        write(level, std::forward<Format>(format)());
+      }
+    }
+  }
+};
+}  // namespace discord_ipc_cpp::logging
+
+#endif  // DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_LOGGER_HPP_
@@ -0,0 +1,159 @@
+/*
+  Copyright 2025 Peter Duanmu
+
+  You should have received a copy of the GNU General Public License along
+  with discord_ipc_cpp. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_LOOPBACK_TRANSPORT_HPP_
+#define DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_LOOPBACK_TRANSPORT_HPP_
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+#include "discord_ipc_cpp/transport.hpp"
+
+namespace discord_ipc_cpp::websockets {
+/**
+ * \brief Shared state between two connected loopback transports.
+ */
+struct LoopbackChannel;
+
+/**
+ * \brief In-memory transport.
+ *
+ * One end of a pair of connected in-memory byte streams. Bytes sent on one end
+ * are received on the other through lock-free ring buffers, without any system
+ * calls or files. This allows the protocol stack to be exercised and measured
+ * in isolation from the operating system.
+ *
+ * \note Each direction is a single-consumer ring. Concurrent senders on the
+ *       same end are serialized with a spin flag.
+ *
+ * \see create_pair
+ * \see discord_ipc_cpp::queues::SpscQueue
+ */
+class LoopbackTransport : public Transport {
+ private:
+  /**
+   * \brief Channel shared with the peer transport.
+   */
+  std::shared_ptr<LoopbackChannel> _channel;
+  /**
+   * \brief Which side of \ref _channel this transport represents.
+   */
+  int _side;
+  /**
+   * \brief If waits for bytes return at once, until reopened.
+   */
+  std::atomic_bool _interrupted { false };
+
+ private:
+  /**
+   * \brief Creates one end of a loopback channel.
+   *
+   * \param channel Shared channel.
+   * \param side Side of the channel, either \c 0 or \c 1.
+   */
+  LoopbackTransport(std::shared_ptr<LoopbackChannel> channel, int side);
+
+ public:
+  /**
+   * \brief Creates a connected pair of loopback transports.
+   *
+   * \param capacity Capacity in bytes of each direction, rounded up to a power
+   *        of two.
+   *
+   * \return Both ends of the channel. Bytes sent on \c first are received on
+   *         \c second and vice versa.
+   */
+  static std::pair<
+    std::unique_ptr<LoopbackTransport>,
+    std::unique_ptr<LoopbackTransport>
+  > create_pair(size_t capacity = 1 << 16);
+
+  /**
+   * \brief Closes this end of the channel.
+   *
+   * \see close
+   */
+  ~LoopbackTransport() override;
+
+  /**
+   * \brief Opens this end of the channel.
+   *
+   * Reopening after \ref close discards any bytes still waiting to be
+   * received on this end, so the channel can be reconnected like a socket.
+   *
+   * \return Success of opening this end, which fails while the other end is
+   *         closed.
+   */
+  bool connect() override;
+  /**
+   * \brief Closes this end of the channel.
+   *
+   * The peer will still receive all bytes sent before closing, after which its
+   * receives indicate a closed connection.
+   *
+   * \return Success of closing this end.
+   */
+  bool close() override;
+  /**
+   * \brief Checks if this end is open.
+   *
+   * \return If this end is open.
+   */
+  bool is_connected() const override;
+  /**
+   * \brief Makes waits for bytes on this end return at once.
+   */
+  void interrupt() override;
+
+  /**
+   * \brief Waits for bytes from the peer.
+   *
+   * \param timeout Time to wait in milliseconds. A negative value waits
+   *        indefinitely.
+   *
+   * \return If bytes or a closure can be read without blocking.
+   */
+  bool wait_readable(int timeout) override;
+  /**
+   * \brief Waits for space in the peer's ring buffer.
+   *
+   * \param timeout Time to wait in milliseconds. A negative value waits
+   *        indefinitely.
+   *
+   * \return If bytes can be sent without blocking, or \c false if either end
+   *         is closed.
+   */
+  bool wait_writable(int timeout) override;
+
+  /**
+   * \brief Sends bytes to the peer.
+   *
+   * Blocks while the ring buffer is full and the peer is still open.
+   *
+   * \param data Start of the buffer to send.
+   * \param size Size of the buffer.
+   *
+   * \return Number of bytes sent, or \c -1 if either end is closed.
+   */
+  ssize_t send_some(const char* data, size_t size) override;
+  /**
+   * \brief Receives bytes from the peer.
+   *
+   * Blocks until at least one byte is available or the peer closes.
+   *
+   * \param buffer Buffer to store received bytes into.
+   * \param size Maximum number of bytes to receive.
+   *
+   * \return Number of bytes received, \c 0 if the peer closed, or \c -1 if
+   *         this end is closed.
+   */
+  ssize_t recv_some(char* buffer, size_t size) override;
+};
+}  // namespace discord_ipc_cpp::websockets
+
+#endif  // DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_LOOPBACK_TRANSPORT_HPP_
@@ -0,0 +1,381 @@
+/*
+  Copyright 2025 Peter Duanmu
+
+  You should have received a copy of the GNU General Public License along
+  with discord_ipc_cpp. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_METRICS_HPP_
+#define DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_METRICS_HPP_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * \namespace discord_ipc_cpp::metrics
+ *
+ * \brief Runtime metrics.
+ *
+ * Contains the lock-free counters and latency histograms recorded by the
+ * client, and the snapshots they are read through.
+ */
+namespace discord_ipc_cpp::metrics {
+/**
+ * \brief Number of IPC opcodes counted separately.
+ *
+ * \see discord_ipc_cpp::ipc_types::Opcode
+ */
+inline constexpr size_t opcode_count = 5;
+
+/**
+ * \brief Counted events.
+ */
+enum Counter : int {
+  mc_retries = 0,               ///< Scheduled presences requeued after a
+                                ///< failed write
+  mc_dropped_updates = 1,       ///< Frames rejected by a full or closed lane
+  mc_coalesced_updates = 2,     ///< Scheduled presences replaced before
+                                ///< sending
+  mc_connects = 3,              ///< Successful connections
+  mc_reconnects = 4,            ///< Successful connections after the first
+  mc_deduplicated_updates = 5,  ///< Presences skipped as already shown
+  mc_oversized_frames = 6,      ///< Received frames discarded for their size
+  mc_malformed_frames = 7,      ///< Received frames with an invalid header
+  counter_count = 8
+};
+
+/**
+ * \brief Timed operations.
+ */
+enum Timer : int {
+  mt_serialize = 0,     ///< Encoding a payload into a frame
+  mt_parse = 1,         ///< Parsing a received payload
+  mt_socket_write = 2,  ///< Writing a batch of frames to the socket
+  mt_round_trip = 3,    ///< Sending a command until its reply is received
+  mt_heartbeat = 4,     ///< Sending a health probe until it is answered
+  timer_count = 5
+};
+
+/**
+ * \brief Copy of a histogram at a point in time.
+ */
+struct HistogramSnapshot {
+  /**
+   * \brief Number of recorded values.
+   */
+  uint64_t count;
+  /**
+   * \brief Sum of recorded values.
+   */
+  uint64_t sum;
+  /**
+   * \brief Largest recorded value.
+   */
+  uint64_t max;
+  /**
+   * \brief Number of values recorded in each bucket.
+   *
+   * \see LatencyHistogram::bucket_index
+   */
+  std::vector<uint64_t> buckets;
+
+  /**
+   * \brief Estimates a percentile.
+   *
+   * \param percentile Percentile between \c 0 and \c 100.
+   *
+   * \return Upper bound of the bucket holding \p percentile, which is within
+   *         about 6% of the exact value, or \c 0 if nothing was recorded.
+   */
+  uint64_t percentile(double percentile) const;
+  /**
+   * \brief Mean of recorded values.
+   *
+   * \return Mean, or \c 0 if nothing was recorded.
+   */
+  double mean() const;
+};
+
+/**
+ * \brief Lock-free log-linear histogram of nanosecond durations.
+ *
+ * Values are bucketed by their highest set bit, and each power of two is
+ * split into 16 linear sub-buckets, as in HdrHistogram. This keeps the
+ * relative error of every bucket below 1/16 while covering nanoseconds to
+ * minutes in under 600 buckets. Recording is a few relaxed atomic adds.
+ */
+class LatencyHistogram {
+ public:
+  /**
+   * \brief Number of bits resolved within each power of two.
+   */
+  static constexpr int sub_bucket_bits = 4;
+  /**
+   * \brief Number of linear sub-buckets per power of two.
+   */
+  static constexpr uint64_t sub_bucket_count = 1 << sub_bucket_bits;
+  /**
+   * \brief Number of bits of the largest value distinguished.
+   *
+   * Larger values, above about 18 minutes, are counted in the last bucket.
+   */
+  static constexpr int max_value_bits = 40;
+  /**
+   * \brief Number of buckets.
+   */
+  static constexpr size_t bucket_count =
+    (max_value_bits - sub_bucket_bits + 1) * sub_bucket_count;
+
+ private:
+  /**
+   * \brief Number of values recorded in each bucket.
+   */
+  std::array<std::atomic<uint64_t>, bucket_count> _buckets {};
+  /**
+   * \brief Sum of recorded values.
+   */
+  std::atomic<uint64_t> _sum { 0 };
+  /**
+   * \brief Largest recorded value.
+   */
+  std::atomic<uint64_t> _max { 0 };
+
+ public:
+  /**
+   * \brief Finds the bucket of a value.
+   *
+   * \param value Value to bucket.
+   *
+   * \return Index of the bucket counting \p value.
+   */
+  static constexpr size_t bucket_index(uint64_t value) {
+    value = std::min<uint64_t>(value, (uint64_t(1) << max_value_bits) - 1);
+
+    if (value < 2 * sub_bucket_count) {
+      return value;
+    }
+
+    int shift = std::bit_width(value) - 1 - sub_bucket_bits;
+
+    return (shift + 1) * sub_bucket_count +
+           ((value >> shift) - sub_bucket_count);
+  }
+  /**
+   * \brief Finds the largest value of a bucket.
+   *
+   * \param index Index of the bucket.
+   *
+   * \return Largest value counted in bucket \p index.
+   */
+  static constexpr uint64_t bucket_upper_bound(size_t index) {
+    if (index < 2 * sub_bucket_count) {
+      return index;
+    }
+
+    int shift = index / sub_bucket_count - 1;
+
+    return ((index % sub_bucket_count + sub_bucket_count) << shift) +
+           (uint64_t(1) << shift) - 1;
+  }
+
+  /**
+   * \brief Records a value. Safe from any thread.
+   *
+   * \param value Value in nanoseconds.
+   */
+  void record(uint64_t value) {
+    _buckets[bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+    _sum.fetch_add(value, std::memory_order_relaxed);
+
+    uint64_t max = _max.load(std::memory_order_relaxed);
+
+    while (value > max && !_max.compare_exchange_weak(
+             max, value, std::memory_order_relaxed)) {
+    }
+  }
+  /**
+   * \brief Records a duration. Safe from any thread.
+   *
+   * \param duration Duration to record, clamped to zero if negative.
+   */
+  template<typename Rep, typename Period>
+  void record(std::chrono::duration<Rep, Period> duration) {
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      duration).count();
+
+    record(static_cast<uint64_t>(std::max<decltype(ns)>(ns, 0)));
+  }
+
+  /**
+   * \brief Copies the histogram.
+   *
+   * \note Values recorded concurrently may be partially included.
+   */
+  HistogramSnapshot snapshot() const;
+};
+
+/**
+ * \brief Frames and bytes moved for a single opcode.
+ */
+struct OpcodeCounters {
+  /**
+   * \brief Frames written to the socket.
+   */
+  uint64_t frames_sent;
+  /**
+   * \brief Bytes written to the socket, including frame headers.
+   */
+  uint64_t bytes_sent;
+  /**
+   * \brief Frames read from the socket.
+   */
+  uint64_t frames_received;
+  /**
+   * \brief Bytes read from the socket, including frame headers.
+   */
+  uint64_t bytes_received;
+};
+
+/**
+ * \brief Copy of every metric at a point in time.
+ */
+struct Snapshot {
+  /**
+   * \brief Traffic, indexed by opcode.
+   */
+  std::array<OpcodeCounters, opcode_count> opcodes;
+  /**
+   * \brief Event counts, indexed by \ref Counter.
+   */
+  std::array<uint64_t, counter_count> counters;
+  /**
+   * \brief Durations in nanoseconds, indexed by \ref Timer.
+   */
+  std::array<HistogramSnapshot, timer_count> timers;
+};
+
+/**
+ * \brief Lock-free store of the client's metrics.
+ */
+class Registry {
+ private:
+  /**
+   * \brief Atomic counterpart of \ref OpcodeCounters.
+   */
+  struct AtomicOpcodeCounters {
+    std::atomic<uint64_t> frames_sent { 0 };
+    std::atomic<uint64_t> bytes_sent { 0 };
+    std::atomic<uint64_t> frames_received { 0 };
+    std::atomic<uint64_t> bytes_received { 0 };
+  };
+
+  /**
+   * \brief Traffic, indexed by opcode.
+   */
+  std::array<AtomicOpcodeCounters, opcode_count> _opcodes;
+  /**
+   * \brief Event counts, indexed by \ref Counter.
+   */
+  std::array<std::atomic<uint64_t>, counter_count> _counters {};
+  /**
+   * \brief Durations, indexed by \ref Timer.
+   */
+  std::array<LatencyHistogram, timer_count> _timers;
+
+ public:
+  /**
+   * \brief Counts a frame written to the socket.
+   *
+   * \param opcode Opcode of the frame, ignored if unknown.
+   * \param bytes Size of the frame.
+   */
+  void count_sent(int opcode, size_t bytes) {
+    if (opcode >= 0 && static_cast<size_t>(opcode) < opcode_count) {
+      _opcodes[opcode].frames_sent.fetch_add(1, std::memory_order_relaxed);
+      _opcodes[opcode].bytes_sent.fetch_add(bytes, std::memory_order_relaxed);
+    }
+  }
+  /**
+   * \brief Counts a frame read from the socket.
+   *
+   * \param opcode Opcode of the frame, ignored if unknown.
+   * \param bytes Size of the frame.
+   */
+  void count_received(int opcode, size_t bytes) {
+    if (opcode >= 0 && static_cast<size_t>(opcode) < opcode_count) {
+      _opcodes[opcode].frames_received.fetch_add(
+        1, std::memory_order_relaxed);
+      _opcodes[opcode].bytes_received.fetch_add(
+        bytes, std::memory_order_relaxed);
+    }
+  }
+  /**
+   * \brief Counts an event.
+   *
+   * \param counter Event to count.
+   * \param amount Number of occurrences.
+   *
+   * \return Count including \p amount.
+   */
+  uint64_t increment(Counter counter, uint64_t amount = 1) {
+    return _counters[counter].fetch_add(amount, std::memory_order_relaxed) +
+           amount;
+  }
+  /**
+   * \brief Retrieves the histogram of a timed operation.
+   *
+   * \param timer Timed operation.
+   *
+   * \return Histogram to record durations of \p timer in.
+   */
+  LatencyHistogram& timer(Timer timer) {
+    return _timers[timer];
+  }
+
+  /**
+   * \brief Copies every metric.
+   */
+  Snapshot snapshot() const;
+};
+
+/**
+ * \brief Records the lifetime of the timer into a histogram.
+ */
+class ScopedTimer {
+ private:
+  /**
+   * \brief Histogram to record into.
+   */
+  LatencyHistogram& _histogram;
+  /**
+   * \brief Time the timer was created.
+   */
+  std::chrono::steady_clock::time_point _start;
+
+ public:
+  /**
+   * \brief Starts the timer.
+   *
+   * \param histogram Histogram to record into.
+   */
+  explicit ScopedTimer(LatencyHistogram& histogram)
+  : _histogram(histogram), _start(std::chrono::steady_clock::now()) {}
+  /**
+   * \brief Records the time elapsed since creation.
+   */
+  ~ScopedTimer() {
+    _histogram.record(std::chrono::steady_clock::now() - _start);
+  }
+
+  ScopedTimer(const ScopedTimer&) = delete;
+  ScopedTimer& operator=(const ScopedTimer&) = delete;
+};
+}  // namespace discord_ipc_cpp::metrics
+
+#endif  // DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_METRICS_HPP_
@@ -0,0 +1,176 @@
+/*
+  Copyright 2025 Peter Duanmu
+
+  You should have received a copy of the GNU General Public License along
+  with discord_ipc_cpp. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_MPSC_QUEUE_HPP_
+#define DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_MPSC_QUEUE_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "discord_ipc_cpp/spsc_queue.hpp"
+
+namespace discord_ipc_cpp::queues {
+/**
+ * \brief Bounded lock-free multi-producer single-consumer queue.
+ *
+ * Each slot carries a sequence number telling producers and the consumer
+ * whose turn it is, so producers only contend on a single counter and never
+ * wait on each other while copying elements in. Slots are padded to a cache
+ * line so that neighbouring producers do not falsely share.
+ *
+ * \tparam T Type of the elements, which must be default-constructible.
+ *
+ * \note Any number of threads may push, but only one thread may pop at a time.
+ */
+template<typename T>
+class MpscQueue {
+ private:
+  /**
+   * \brief Slot of the ring.
+   */
+  struct alignas(cache_line_size) Slot {
+    /**
+     * \brief Index the slot is ready for.
+     *
+     * Equal to the push index when free, and to the push index plus one once
+     * filled.
+     */
+    std::atomic<size_t> sequence;
+    /**
+     * \brief Stored element.
+     */
+    T value;
+  };
+
+  /**
+   * \brief Slots of the ring.
+   */
+  std::unique_ptr<Slot[]> _slots;
+  /**
+   * \brief Number of slots minus one.
+   */
+  const size_t _mask;
+
+  /**
+   * \brief Index of the next slot to push, shared by producers.
+   */
+  alignas(cache_line_size) std::atomic<size_t> _tail { 0 };
+  /**
+   * \brief Index of the next slot to pop, written by the consumer.
+   */
+  alignas(cache_line_size) std::atomic<size_t> _head { 0 };
+
+ public:
+  /**
+   * \brief Creates the queue.
+   *
+   * \param capacity Maximum number of elements, rounded up to a power of two.
+   */
+  explicit MpscQueue(size_t capacity)
+  : _slots(std::make_unique<Slot[]>(round_up_capacity(capacity))),
+  _mask(round_up_capacity(capacity) - 1) {
+    for (size_t i = 0; i <= _mask; ++i) {
+      _slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  MpscQueue(const MpscQueue&) = delete;
+  MpscQueue& operator=(const MpscQueue&) = delete;
+
+  /**
+   * \brief Pushes an element. Safe from any thread.
+   *
+   * \param value Element to push.
+   *
+   * \return If the element was pushed, which fails when full.
+   */
+  bool try_push(T value) {
+    size_t tail = _tail.load(std::memory_order_relaxed);
+    Slot* slot;
+
+    while (true) {
+      slot = &_slots[tail & _mask];
+
+      size_t sequence = slot->sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<intptr_t>(sequence - tail);
+
+      if (diff == 0) {
+        if (_tail.compare_exchange_weak(
+              tail, tail + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        tail = _tail.load(std::memory_order_relaxed);
+      }
+    }
+
+    slot->value = std::move(value);
+    slot->sequence.store(tail + 1, std::memory_order_release);
+
+    return true;
+  }
+
+  /**
+   * \brief Pops an element. Consumer only.
+   *
+   * \param value Where to store the popped element.
+   *
+   * \return If an element was popped, which fails when empty or when the
+   *         oldest push has not finished yet.
+   */
+  bool try_pop(T* value) {
+    size_t head = _head.load(std::memory_order_relaxed);
+    Slot& slot = _slots[head & _mask];
+
+    if (slot.sequence.load(std::memory_order_acquire) != head + 1) {
+      return false;
+    }
+
+    *value = std::move(slot.value);
+    slot.value = T();
+    slot.sequence.store(head + _mask + 1, std::memory_order_release);
+
+    _head.store(head + 1, std::memory_order_release);
+
+    return true;
+  }
+
+  /**
+   * \brief Checks if an element is ready to be popped. Safe from any thread.
+   *
+   * \return If the oldest element has been fully pushed.
+   */
+  bool has_ready() const {
+    size_t head = _head.load(std::memory_order_acquire);
+
+    return _slots[head & _mask].sequence.load(std::memory_order_acquire) ==
+           head + 1;
+  }
+  /**
+   * \brief Approximate number of elements in the queue.
+   */
+  size_t size() const {
+    size_t head = _head.load(std::memory_order_acquire);
+    size_t tail = _tail.load(std::memory_order_acquire);
+
+    return tail > head ? tail - head : 0;
+  }
+  /**
+   * \brief Maximum number of elements.
+   */
+  size_t capacity() const {
+    return _mask + 1;
+  }
+};
+}  // namespace discord_ipc_cpp::queues
+
+#endif  // DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_MPSC_QUEUE_HPP_
@@ -0,0 +1,204 @@
+/*
+  Copyright 2025 Peter Duanmu
+
+  You should have received a copy of the GNU General Public License along
+  with discord_ipc_cpp. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_PRESENCE_SCHEDULER_HPP_
+#define DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_PRESENCE_SCHEDULER_HPP_
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+#include "discord_ipc_cpp/ipc_types.hpp"
+
+/**
+ * \namespace discord_ipc_cpp::scheduling
+ *
+ * \brief Outbound traffic shaping.
+ *
+ * Contains the classes that decide when outbound payloads may be sent, keeping
+ * the client within Discord's rate limits.
+ */
+namespace discord_ipc_cpp::scheduling {
+/**
+ * \brief Sliding window rate limiter.
+ *
+ * Remembers the times of the most recent sends, allowing a send only while
+ * fewer than a fixed number of them fall within the window ending now. Unlike
+ * a token bucket refilled continuously, no window of the given period ever
+ * holds more than the given number of sends.
+ */
+class SlidingWindow {
+ public:
+  /**
+   * \brief Clock used for timing sends.
+   */
+  using Clock = std::chrono::steady_clock;
+
+ private:
+  /**
+   * \brief Maximum number of sends within \ref _period.
+   */
+  size_t _limit;
+  /**
+   * \brief Length of the window.
+   */
+  Clock::duration _period;
+  /**
+   * \brief Times of the sends within the window, oldest first.
+   */
+  std::deque<Clock::time_point> _sends;
+
+ private:
+  /**
+   * \brief Forgets sends that left the window.
+   *
+   * \param now Current time.
+   */
+  void expire(Clock::time_point now);
+
+ public:
+  /**
+   * \brief Creates a window without any sends.
+   *
+   * \param limit Maximum number of sends within \p period.
+   * \param period Length of the window.
+   */
+  SlidingWindow(size_t limit, Clock::duration period);
+
+  /**
+   * \brief Attempts to record a send.
+   *
+   * \param now Current time.
+   *
+   * \return If the send is allowed and was recorded.
+   */
+  bool try_acquire(Clock::time_point now);
+  /**
+   * \brief Forgets the most recently recorded send.
+   */
+  void refund();
+  /**
+   * \brief Time until a send is allowed.
+   *
+   * \param now Current time.
+   *
+   * \return Zero if a send is allowed now.
+   */
+  Clock::duration time_until_available(Clock::time_point now);
+};
+
+/**
+ * \brief Latest-wins presence scheduler.
+ *
+ * Holds at most one pending presence payload. Offering a new payload replaces
+ * any pending one, and a payload is only released when the sliding window
+ * allows it. This keeps presence updates under Discord's rate limit with
+ * minimal staleness, without ever blocking the caller.
+ *
+ * \note All methods are thread-safe.
+ */
+class PresenceScheduler {
+ public:
+  /**
+   * \brief Clock used for scheduling.
+   */
+  using Clock = SlidingWindow::Clock;
+
+ private:
+  /**
+   * \brief Guards all members.
+   */
+  mutable std::mutex _mutex;
+  /**
+   * \brief Rate limiter for releasing payloads.
+   */
+  SlidingWindow _window;
+  /**
+   * \brief Newest presence payload waiting to be sent.
+   */
+  std::optional<ipc_types::Payload> _pending;
+  /**
+   * \brief Sequence number the caller gave \ref _pending.
+   */
+  uint64_t _pending_sequence;
+  /**
+   * \brief Number of payloads replaced before being sent.
+   */
+  uint64_t _coalesced;
+
+ public:
+  /**
+   * \brief Creates the scheduler.
+   *
+   * \param burst Maximum number of updates sent within any \p period.
+   * \param period Length of the window limiting updates to \p burst.
+   */
+  PresenceScheduler(size_t burst, Clock::duration period);
+
+  /**
+   * \brief Replaces the rate limit.
+   *
+   * \param burst Maximum number of updates sent within any \p period.
+   * \param period Length of the window limiting updates to \p burst.
+   */
+  void set_rate_limit(size_t burst, Clock::duration period);
+
+  /**
+   * \brief Offers a payload for sending.
+   *
+   * \param payload Presence payload to send.
+   * \param sequence Sequence number returned with \p payload by \ref poll.
+   *
+   * \return If a pending payload was superseded by \p payload.
+   */
+  bool offer(const ipc_types::Payload& payload, uint64_t sequence = 0);
+  /**
+   * \brief Releases the pending payload if the rate limit allows it.
+   *
+   * \param now Current time.
+   * \param sequence Receives the sequence number offered with the payload,
+   *        may be \c nullptr.
+   *
+   * \return Payload to send now, if any.
+   */
+  std::optional<ipc_types::Payload> poll(
+    Clock::time_point now, uint64_t* sequence = nullptr);
+  /**
+   * \brief Returns a payload that failed to send.
+   *
+   * The payload is only restored if it has not been superseded in the
+   * meantime, and its send is forgotten by the rate limit.
+   *
+   * \param payload Payload previously returned by \ref poll.
+   * \param sequence Sequence number returned with \p payload.
+   */
+  void restore(const ipc_types::Payload& payload, uint64_t sequence = 0);
+  /**
+   * \brief Drops the pending payload.
+   */
+  void clear();
+
+  /**
+   * \brief Time until the pending payload can be released.
+   *
+   * \param now Current time.
+   *
+   * \return Empty if there is no pending payload.
+   */
+  std::optional<Clock::duration> next_release(Clock::time_point now);
+  /**
+   * \brief Number of payloads superseded before being sent.
+   *
+   * \return Count of coalesced updates.
+   */
+  uint64_t coalesced() const;
+};
+}  // namespace discord_ipc_cpp::scheduling
+
+#endif  // DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_PRESENCE_SCHEDULER_HPP_
@@ -0,0 +1,112 @@
+/*
+  Copyright 2025 Peter Duanmu
+
+  You should have received a copy of the GNU General Public License along
+  with discord_ipc_cpp. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_PRESENCE_TEMPLATE_HPP_
+#define DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_PRESENCE_TEMPLATE_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "discord_ipc_cpp/ipc_types.hpp"
+
+namespace discord_ipc_cpp::ipc_types {
+/**
+ * \brief Fields of a presence that change between updates.
+ *
+ * \see PresenceTemplate
+ */
+struct PresenceUpdate {
+  /**
+   * \brief First line of the activity, omitted if empty.
+   */
+  std::optional<std::string> details { std::nullopt };
+  /**
+   * \brief Second line of the activity, omitted if empty.
+   */
+  std::optional<std::string> state { std::nullopt };
+  /**
+   * \brief Timestamps of the activity, omitted if empty.
+   */
+  std::optional<RichPresence::Timestamps> timestamps { std::nullopt };
+
+  /**
+   * \brief Compares every field.
+   */
+  bool operator==(const PresenceUpdate&) const = default;
+};
+
+/**
+ * \brief A presence serialized once, with slots for its frequently changing
+ *        fields.
+ *
+ * The \c SET_ACTIVITY command of a base presence is serialized into fixed
+ * fragments around the \c details, \c state and \c timestamps fields. Each
+ * update then only escapes the changed fields and splices them between the
+ * fragments, producing the same bytes as serializing the full presence.
+ *
+ * \code{.cpp}
+ * auto song = client.make_presence_template(base);
+ *
+ * client.set_presence(song, { .details = title, .state = artist });
+ * \endcode
+ */
+class PresenceTemplate {
+ private:
+  /**
+   * \brief Number of fragments around the three slots.
+   */
+  static constexpr size_t fragment_count = 4;
+
+  /**
+   * \brief ID distinguishing the template from others.
+   */
+  uint64_t _id;
+  /**
+   * \brief Serialized command around the slots, in order.
+   *
+   * The last fragment holds the nonce.
+   */
+  std::array<std::string, fragment_count> _fragments;
+  /**
+   * \brief Offset of the nonce within the last fragment.
+   */
+  size_t _nonce_offset;
+
+ public:
+  /**
+   * \brief Serializes the fixed parts of a presence.
+   *
+   * \param base Presence whose fields other than \c details, \c state and
+   *        \c timestamps are kept for every update.
+   * \param pid Process ID sent with the presence.
+   */
+  PresenceTemplate(const RichPresence& base, int pid);
+
+  /**
+   * \brief ID of the template, unique within the process.
+   */
+  uint64_t id() const;
+
+  /**
+   * \brief Encodes a \c SET_ACTIVITY frame.
+   *
+   * \param update Values of the slots.
+   * \param nonce Nonce of the command, which must be 36 characters long.
+   *
+   * \return Frame including its header, ready to be written.
+   */
+  std::vector<char> render(
+    const PresenceUpdate& update, std::string_view nonce) const;
+};
+}  // namespace discord_ipc_cpp::ipc_types
+
+#endif  // DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_PRESENCE_TEMPLATE_HPP_
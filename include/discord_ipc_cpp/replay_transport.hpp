@@ -0,0 +1,186 @@
+/*
+  Copyright 2025 Peter Duanmu
+
+  You should have received a copy of the GNU General Public License along
+  with discord_ipc_cpp. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_REPLAY_TRANSPORT_HPP_
+#define DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_REPLAY_TRANSPORT_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "discord_ipc_cpp/capture.hpp"
+#include "discord_ipc_cpp/transport.hpp"
+
+namespace discord_ipc_cpp::websockets {
+/**
+ * \brief Transport playing back a capture.
+ *
+ * Every connection receives the inbound frames of a capture, each becoming
+ * readable at the same offset from connecting as it was received from the
+ * start of the capture, divided by the playback speed. Sent bytes are
+ * accepted and dropped. Once every frame has been received, the connection
+ * reports the peer closing it, and connecting again restarts the playback.
+ *
+ * Used to benchmark the client and reproduce problems against traffic
+ * captured from Discord.
+ *
+ * \see discord_ipc_cpp::capture::CaptureWriter
+ */
+class ReplayTransport : public Transport {
+ private:
+  /**
+   * \brief Clock used for pacing frames.
+   */
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * \brief Capture being played back.
+   */
+  std::shared_ptr<const capture::CaptureReader> _capture;
+  /**
+   * \brief Indices of the inbound frames of \ref _capture.
+   */
+  std::vector<size_t> _inbound;
+  /**
+   * \brief Timestamp of the first frame of \ref _capture.
+   */
+  int64_t _origin;
+  /**
+   * \brief Playback speed, where \c 0 plays frames without delay.
+   */
+  double _speed;
+
+  /**
+   * \brief Guards the playback position.
+   */
+  mutable std::mutex _mutex;
+  /**
+   * \brief Wakes waits for the next frame when closed or interrupted.
+   */
+  std::condition_variable _cv;
+  /**
+   * \brief If the connection is open.
+   */
+  std::atomic_bool _connected;
+  /**
+   * \brief If waits for the next frame return at once, until reconnected.
+   */
+  bool _interrupted;
+  /**
+   * \brief Time the connection was opened.
+   */
+  Clock::time_point _start;
+  /**
+   * \brief Position in \ref _inbound of the frame being received.
+   */
+  size_t _next;
+  /**
+   * \brief Bytes of the frame being received already received.
+   */
+  size_t _offset;
+
+ private:
+  /**
+   * \brief Time the frame at \p position becomes readable.
+   */
+  Clock::time_point due(size_t position) const;
+  /**
+   * \brief Waits until the next frame is readable or the wait is cut short.
+   *
+   * \param lock Lock held on \ref _mutex.
+   * \param deadline Time to stop waiting at.
+   *
+   * \return If the next frame or the end of the capture can be received.
+   */
+  bool wait_due(std::unique_lock<std::mutex>& lock,
+                Clock::time_point deadline);
+
+ public:
+  /**
+   * \brief Creates a closed transport playing back \p capture.
+   *
+   * \param capture Capture to play back, which must stay open.
+   * \param speed Playback speed, such as \c 1 for the original pace or \c 10
+   *        for ten times faster. Zero plays frames without delay.
+   */
+  explicit ReplayTransport(
+    std::shared_ptr<const capture::CaptureReader> capture, double speed = 1);
+
+  /**
+   * \brief Checks if every frame of the current connection was received.
+   */
+  bool finished() const;
+
+  /**
+   * \brief Opens the connection and restarts the playback.
+   *
+   * \return Always \c true.
+   */
+  bool connect() override;
+  /**
+   * \brief Closes the connection.
+   *
+   * \return Success of closing, which fails if it was not open.
+   */
+  bool close() override;
+  /**
+   * \brief Checks if the connection is open.
+   *
+   * \return If the connection is open, until the end of the capture has been
+   *         received.
+   */
+  bool is_connected() const override;
+  /**
+   * \brief Makes waits for the next frame return at once.
+   */
+  void interrupt() override;
+
+  /**
+   * \brief Waits for the next frame to become readable.
+   *
+   * \param timeout Time to wait in milliseconds. A negative value waits
+   *        indefinitely.
+   *
+   * \return If the next frame or the end of the capture can be received.
+   */
+  bool wait_readable(int timeout) override;
+  /**
+   * \brief Checks if the connection is open, as sends never block.
+   *
+   * \param timeout Unused.
+   *
+   * \return If the connection is open.
+   */
+  bool wait_writable(int timeout) override;
+
+  /**
+   * \brief Drops sent bytes.
+   *
+   * \param data Start of the buffer to send.
+   * \param size Size of the buffer.
+   *
+   * \return \p size, or \c -1 if the connection is closed.
+   */
+  ssize_t send_some(const char* data, size_t size) override;
+  /**
+   * \brief Receives part of the next frame, waiting until it is due.
+   *
+   * \param buffer Buffer to store received bytes into.
+   * \param size Maximum number of bytes to receive.
+   *
+   * \return Number of bytes received, \c 0 once the capture is exhausted or
+   *         when interrupted, or \c -1 if the connection is closed.
+   */
+  ssize_t recv_some(char* buffer, size_t size) override;
+};
+}  // namespace discord_ipc_cpp::websockets
+
+#endif  // DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_REPLAY_TRANSPORT_HPP_
@@ -12,9 +12,10 @@
 #include <sys/socket.h>
 #include <sys/un.h>
 
+#include <atomic>
 #include <string>
-#include <optional>
-#include <vector>
+
+#include "discord_ipc_cpp/transport.hpp"
 
 /**
  * \namespace discord_ipc_cpp::websockets
@@ -31,8 +32,9 @@ namespace discord_ipc_cpp::websockets {
  * work with websockets surprisingly.
  *
  * \see discord_ipc_cpp::DiscordIPCClient
+ * \see discord_ipc_cpp::websockets::Transport
  */
-class SocketClient {
+class SocketClient : public Transport {
  private:
   /**
    * \brief Path to the IPC file.
@@ -43,6 +45,11 @@ class SocketClient {
    * \brief Success of binding to IPC file.
    */
   int _client_socket;
+  /**
+   * \brief Success of connecting to IPC file, cleared once the peer closes
+   *        the connection.
+   */
+  std::atomic_bool _connected;
   /**
    * \brief Address information of the IPC file.
    */
@@ -63,60 +70,79 @@ class SocketClient {
    *
    * \see close
    */
-  ~SocketClient();
+  ~SocketClient() override;
 
   /**
    * \brief Attempts to connect to the socket file.
    *
+   * Opens a new socket if the previous one was closed, so a closed client can
+   * reconnect.
+   *
    * \return Success of opening connection to socket file.
    */
-  bool connect();
+  bool connect() override;
   /**
    * \brief Attempts to close connection to socket file.
    *
    * \return Success of closing connection to socket file.
    */
-  bool close();
-
+  bool close() override;
   /**
-   * \brief Sends data to socket.
+   * \brief Checks if the socket file is connected.
    *
-   * This will attempt to send a byte buffer of data to the socket file.
+   * \return If the socket is connected.
+   */
+  bool is_connected() const override;
+  /**
+   * \brief Shuts the socket down without closing it, waking any poll.
+   */
+  void interrupt() override;
+
+  /**
+   * \brief Polls the socket for incoming data.
    *
-   * \param data Data to send.
+   * \param timeout Time to wait in milliseconds.
    *
-   * \return Success of sending data.
+   * \return If the socket contains data that can be retrieved.
    */
-  bool send_data(const std::vector<char>& data);
+  bool wait_readable(int timeout) override;
   /**
-   * \brief Receive data from socket.
+   * \brief Polls the socket for available send buffer space.
    *
-   * Attempts to retrieve data from the socket in a blocking manner. An empty
-   * optional will be returned if an error occurred while retrieving data from
-   * the socket.
+   * \param timeout Time to wait in milliseconds.
    *
-   * \param buffer_size Size of data to retrieve.
+   * \return If the socket can accept more data.
+   */
+  bool wait_writable(int timeout) override;
+
+  /**
+   * \brief Sends part of a buffer to the socket.
    *
-   * \return Data from socket if successful.
+   * \param data Start of the buffer to send.
+   * \param size Size of the buffer.
    *
-   * \see recv_data(int,int)
+   * \return Number of bytes sent, or \c -1 on error.
    */
-  std::optional<std::vector<char>> recv_data(int buffer_size);
+  ssize_t send_some(const char* data, size_t size) override;
   /**
-   * \brief Receive data from socket on timeout.
+   * \brief Sends part of several buffers with a single \c sendmsg call.
    *
-   * Polls the socket for data in a blocking manner. If the socket contains data
-   * that can be retrieved, \ref recv_data(int) will be called to retrieve the
-   * data. If the poll times out, then an empty optional will be returned.
+   * \param buffers Buffers to send.
+   * \param count Number of buffers.
    *
-   * \param buffer_size Size of data to retrieve.
-   * \param timeout Time to wait.
+   * \return Number of bytes sent, or \c -1 on error.
+   */
+  ssize_t send_some_vectored(const struct iovec* buffers, int count) override;
+  /**
+   * \brief Receives part of a buffer from the socket.
    *
-   * \return Data from socket if existant.
+   * \param buffer Buffer to store received bytes into.
+   * \param size Maximum number of bytes to receive.
    *
-   * \see recv_data(int)
+   * \return Number of bytes received, \c 0 if the socket was closed, or \c -1
+   *         on error.
    */
-  std::optional<std::vector<char>> recv_data(int buffer_size, int timeout);
+  ssize_t recv_some(char* buffer, size_t size) override;
 };
 }  // namespace discord_ipc_cpp::websockets
 
@@ -0,0 +1,239 @@
+/*
+  Copyright 2025 Peter Duanmu
+
+  You should have received a copy of the GNU General Public License along
+  with discord_ipc_cpp. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_SPSC_QUEUE_HPP_
+#define DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_SPSC_QUEUE_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+/**
+ * \namespace discord_ipc_cpp::queues
+ *
+ * \brief Lock-free queues.
+ *
+ * Contains the bounded queues used to hand data between threads without
+ * locking.
+ */
+namespace discord_ipc_cpp::queues {
+/**
+ * \brief Size of a cache line, used to keep independently written indices
+ *        from sharing one.
+ */
+inline constexpr size_t cache_line_size = 64;
+
+/**
+ * \brief Rounds a capacity up to a power of two.
+ *
+ * \param value Requested capacity.
+ *
+ * \return Smallest power of two not less than \p value, and at least \c 2.
+ */
+constexpr size_t round_up_capacity(size_t value) {
+  size_t result = 2;
+
+  while (result < value) {
+    result <<= 1;
+  }
+
+  return result;
+}
+
+/**
+ * \brief Bounded lock-free single-producer single-consumer queue.
+ *
+ * A ring of slots indexed by two monotonically increasing counters, each on
+ * its own cache line. Each side also caches the other side's counter, so the
+ * shared cache line is only read when the queue appears full or empty.
+ *
+ * \tparam T Type of the elements, which must be default-constructible.
+ *
+ * \note Exactly one thread may push and exactly one thread may pop at a time.
+ */
+template<typename T>
+class SpscQueue {
+ private:
+  /**
+   * \brief Slots of the ring.
+   */
+  std::unique_ptr<T[]> _slots;
+  /**
+   * \brief Number of slots minus one.
+   */
+  const size_t _mask;
+
+  /**
+   * \brief Index of the next slot to pop, written by the consumer.
+   */
+  alignas(cache_line_size) std::atomic<size_t> _head { 0 };
+  /**
+   * \brief Consumer's last observed value of \ref _tail.
+   */
+  size_t _cached_tail { 0 };
+
+  /**
+   * \brief Index of the next slot to push, written by the producer.
+   */
+  alignas(cache_line_size) std::atomic<size_t> _tail { 0 };
+  /**
+   * \brief Producer's last observed value of \ref _head.
+   */
+  size_t _cached_head { 0 };
+
+ public:
+  /**
+   * \brief Creates the queue.
+   *
+   * \param capacity Maximum number of elements, rounded up to a power of two.
+   */
+  explicit SpscQueue(size_t capacity)
+  : _slots(std::make_unique<T[]>(round_up_capacity(capacity))),
+  _mask(round_up_capacity(capacity) - 1) {}
+
+  SpscQueue(const SpscQueue&) = delete;
+  SpscQueue& operator=(const SpscQueue&) = delete;
+
+  /**
+   * \brief Pushes an element. Producer only.
+   *
+   * \param value Element to push.
+   *
+   * \return If the element was pushed, which fails when full.
+   */
+  bool try_push(T value) {
+    size_t tail = _tail.load(std::memory_order_relaxed);
+
+    if (tail - _cached_head > _mask) {
+      _cached_head = _head.load(std::memory_order_acquire);
+
+      if (tail - _cached_head > _mask) {
+        return false;
+      }
+    }
+
+    _slots[tail & _mask] = std::move(value);
+
+    _tail.store(tail + 1, std::memory_order_release);
+
+    return true;
+  }
+
+  /**
+   * \brief Pops an element. Consumer only.
+   *
+   * \param value Where to store the popped element.
+   *
+   * \return If an element was popped, which fails when empty.
+   */
+  bool try_pop(T* value) {
+    size_t head = _head.load(std::memory_order_relaxed);
+
+    if (head == _cached_tail) {
+      _cached_tail = _tail.load(std::memory_order_acquire);
+
+      if (head == _cached_tail) {
+        return false;
+      }
+    }
+
+    *value = std::move(_slots[head & _mask]);
+
+    _head.store(head + 1, std::memory_order_release);
+
+    return true;
+  }
+
+  /**
+   * \brief Pushes as many elements as fit. Producer only.
+   *
+   * \param data Start of the elements to push.
+   * \param count Number of elements.
+   *
+   * \return Number of elements pushed.
+   */
+  size_t push_bulk(const T* data, size_t count)
+  requires std::is_trivially_copyable_v<T> {
+    size_t tail = _tail.load(std::memory_order_relaxed);
+
+    if (count > capacity() - (tail - _cached_head)) {
+      _cached_head = _head.load(std::memory_order_acquire);
+    }
+
+    count = std::min(count, capacity() - (tail - _cached_head));
+
+    size_t offset = tail & _mask;
+    size_t first = std::min(count, capacity() - offset);
+
+    std::copy_n(data, first, &_slots[offset]);
+    std::copy_n(data + first, count - first, &_slots[0]);
+
+    _tail.store(tail + count, std::memory_order_release);
+
+    return count;
+  }
+
+  /**
+   * \brief Pops as many elements as are available. Consumer only.
+   *
+   * \param data Where to store the popped elements.
+   * \param count Maximum number of elements to pop.
+   *
+   * \return Number of elements popped.
+   */
+  size_t pop_bulk(T* data, size_t count)
+  requires std::is_trivially_copyable_v<T> {
+    size_t head = _head.load(std::memory_order_relaxed);
+
+    if (count > _cached_tail - head) {
+      _cached_tail = _tail.load(std::memory_order_acquire);
+    }
+
+    count = std::min(count, _cached_tail - head);
+
+    size_t offset = head & _mask;
+    size_t first = std::min(count, capacity() - offset);
+
+    std::copy_n(&_slots[offset], first, data);
+    std::copy_n(&_slots[0], count - first, data + first);
+
+    _head.store(head + count, std::memory_order_release);
+
+    return count;
+  }
+
+  /**
+   * \brief Number of elements in the queue.
+   *
+   * \note Exact when called from either the producer or the consumer,
+   *       approximate otherwise.
+   */
+  size_t size() const {
+    return _tail.load(std::memory_order_acquire) -
+           _head.load(std::memory_order_acquire);
+  }
+  /**
+   * \brief Number of elements that can be pushed.
+   *
+   * \see size
+   */
+  size_t free_space() const {
+    return capacity() - size();
+  }
+  /**
+   * \brief Maximum number of elements.
+   */
+  size_t capacity() const {
+    return _mask + 1;
+  }
+};
+}  // namespace discord_ipc_cpp::queues
+
+#endif  // DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_SPSC_QUEUE_HPP_
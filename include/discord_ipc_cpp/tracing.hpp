@@ -0,0 +1,187 @@
+/*
+  Copyright 2025 Peter Duanmu
+
+  You should have received a copy of the GNU General Public License along
+  with discord_ipc_cpp. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_TRACING_HPP_
+#define DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_TRACING_HPP_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * \brief Enables pipeline tracing.
+ *
+ * When \c 0, the tracing macros expand to nothing and no spans are recorded.
+ * Set through the \c DISCORD_IPC_CPP_ENABLE_TRACING CMake option.
+ */
+#ifndef DISCORD_IPC_CPP_ENABLE_TRACING
+#define DISCORD_IPC_CPP_ENABLE_TRACING 0
+#endif
+
+/**
+ * \namespace discord_ipc_cpp::tracing
+ *
+ * \brief Pipeline tracing.
+ *
+ * Records timestamped spans of each stage a request passes through into a
+ * ring buffer owned by the recording thread, and exports them as Chrome trace
+ * event JSON, which can be opened in \c chrome://tracing or Perfetto.
+ */
+namespace discord_ipc_cpp::tracing {
+/**
+ * \brief Clock timestamping spans.
+ */
+using Clock = std::chrono::steady_clock;
+
+/**
+ * \brief If spans are recorded.
+ */
+inline constexpr bool enabled = DISCORD_IPC_CPP_ENABLE_TRACING != 0;
+
+/**
+ * \brief Number of spans kept per thread, after which the oldest are
+ *        overwritten.
+ */
+inline constexpr size_t ring_capacity = 4096;
+
+/**
+ * \brief Records a span on the calling thread's ring.
+ *
+ * \param name Name of the stage, which must outlive the tracer, such as a
+ *        string literal.
+ * \param start Time the stage started.
+ * \param end Time the stage ended.
+ * \param request ID of the request the stage belongs to, or \c 0.
+ */
+void record(
+  const char* name,
+  Clock::time_point start,
+  Clock::time_point end,
+  uint64_t request);
+
+/**
+ * \brief Retrieves the request being traced on the calling thread.
+ *
+ * \return ID of the innermost \ref RequestScope, or \c 0 if there is none or
+ *         tracing is disabled.
+ */
+uint64_t current_request();
+
+/**
+ * \brief Exports every recorded span.
+ *
+ * \return Chrome trace event JSON.
+ *
+ * \note Spans being recorded concurrently may be left out.
+ */
+std::string export_chrome_trace();
+/**
+ * \brief Exports every recorded span to a file.
+ *
+ * \param path Path of the file to write.
+ *
+ * \return If the file was written.
+ *
+ * \see export_chrome_trace
+ */
+bool write_chrome_trace(const std::string& path);
+/**
+ * \brief Discards every recorded span.
+ */
+void clear();
+
+/**
+ * \brief Records a span covering its own lifetime.
+ */
+class ScopedSpan {
+ private:
+  /**
+   * \brief Name of the stage.
+   */
+  const char* _name;
+  /**
+   * \brief Time the stage started.
+   */
+  Clock::time_point _start;
+
+ public:
+  /**
+   * \brief Starts the span.
+   *
+   * \param name Name of the stage, such as a string literal.
+   */
+  explicit ScopedSpan(const char* name)
+  : _name(name), _start(Clock::now()) {}
+  /**
+   * \brief Records the span under the current request.
+   */
+  ~ScopedSpan() {
+    record(_name, _start, Clock::now(), current_request());
+  }
+
+  ScopedSpan(const ScopedSpan&) = delete;
+  ScopedSpan& operator=(const ScopedSpan&) = delete;
+};
+
+/**
+ * \brief Attributes the spans recorded on this thread during its lifetime to
+ *        a new request.
+ */
+class RequestScope {
+ private:
+  /**
+   * \brief Request being traced before this scope.
+   */
+  uint64_t _previous;
+
+ public:
+  /**
+   * \brief Starts a new request.
+   */
+  RequestScope();
+  /**
+   * \brief Restores the previous request.
+   */
+  ~RequestScope();
+
+  RequestScope(const RequestScope&) = delete;
+  RequestScope& operator=(const RequestScope&) = delete;
+};
+}  // namespace discord_ipc_cpp::tracing
+
+#define DISCORD_IPC_CPP_TRACE_CONCAT_INNER(a, b) a##b
+#define DISCORD_IPC_CPP_TRACE_CONCAT(a, b) \
+  DISCORD_IPC_CPP_TRACE_CONCAT_INNER(a, b)
+
+#if DISCORD_IPC_CPP_ENABLE_TRACING
+/**
+ * \brief Records the rest of the enclosing scope as a span named \p name.
+ */
+#define DISCORD_IPC_CPP_TRACE_SCOPE(name)                                    \
+  ::discord_ipc_cpp::tracing::ScopedSpan                                     \
+    DISCORD_IPC_CPP_TRACE_CONCAT(trace_span_, __LINE__)(name)
+/**
+ * \brief Attributes the spans of the rest of the enclosing scope to a new
+ *        request.
+ */
+#define DISCORD_IPC_CPP_TRACE_REQUEST()                                      \
+  ::discord_ipc_cpp::tracing::RequestScope                                   \
+    DISCORD_IPC_CPP_TRACE_CONCAT(trace_request_, __LINE__)
+/**
+ * \brief Records a span named \p name from \p start until now.
+ */
+#define DISCORD_IPC_CPP_TRACE_SINCE(name, start, request)                    \
+  ::discord_ipc_cpp::tracing::record(                                        \
+    name, start, ::discord_ipc_cpp::tracing::Clock::now(), request)
+#else
+#define DISCORD_IPC_CPP_TRACE_SCOPE(name) static_cast<void>(0)
+#define DISCORD_IPC_CPP_TRACE_REQUEST() static_cast<void>(0)
+#define DISCORD_IPC_CPP_TRACE_SINCE(name, start, request) static_cast<void>(0)
+#endif
+
+#endif  // DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_TRACING_HPP_
@@ -0,0 +1,193 @@
+/*
+  Copyright 2025 Peter Duanmu
+
+  You should have received a copy of the GNU General Public License along
+  with discord_ipc_cpp. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_TRANSPORT_HPP_
+#define DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_TRANSPORT_HPP_
+
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include <optional>
+#include <vector>
+
+namespace discord_ipc_cpp::websockets {
+/**
+ * \brief Abstract byte stream connection.
+ *
+ * Describes the minimal set of operations that
+ * \ref discord_ipc_cpp::DiscordIPCClient requires from the underlying
+ * connection. Implementations only provide the primitive operations, while the
+ * buffered \ref send_data and \ref recv_data helpers are shared between all
+ * transports.
+ *
+ * \see discord_ipc_cpp::websockets::SocketClient
+ * \see discord_ipc_cpp::websockets::LoopbackTransport
+ */
+class Transport {
+ public:
+  /**
+   * \brief Cleans up the transport.
+   */
+  virtual ~Transport() = default;
+
+  /**
+   * \brief Attempts to open the connection.
+   *
+   * \return Success of opening the connection.
+   */
+  virtual bool connect() = 0;
+  /**
+   * \brief Attempts to close the connection.
+   *
+   * \return Success of closing the connection.
+   */
+  virtual bool close() = 0;
+  /**
+   * \brief Checks if the connection is open.
+   *
+   * \return If the connection is open.
+   */
+  virtual bool is_connected() const = 0;
+  /**
+   * \brief Wakes a thread waiting for data on the connection.
+   *
+   * Lets a receiving thread be stopped promptly before the connection is
+   * closed. Waits for data then return at once until the connection is opened
+   * again. The default implementation does nothing, so waits only end at
+   * their timeout.
+   */
+  virtual void interrupt();
+
+  /**
+   * \brief Waits for the connection to have data available.
+   *
+   * \param timeout Time to wait in milliseconds. A negative value waits
+   *        indefinitely.
+   *
+   * \return If data can be read without blocking.
+   */
+  virtual bool wait_readable(int timeout) = 0;
+  /**
+   * \brief Waits for the connection to accept more data.
+   *
+   * \param timeout Time to wait in milliseconds. A negative value waits
+   *        indefinitely.
+   *
+   * \return If data can be sent without blocking.
+   */
+  virtual bool wait_writable(int timeout) = 0;
+
+  /**
+   * \brief Sends part of a buffer.
+   *
+   * \param data Start of the buffer to send.
+   * \param size Size of the buffer.
+   *
+   * \return Number of bytes sent, or \c -1 on error with \c errno set.
+   */
+  virtual ssize_t send_some(const char* data, size_t size) = 0;
+  /**
+   * \brief Sends part of several buffers in order.
+   *
+   * The default implementation sends from the first non-empty buffer only.
+   * Transports that support gathered writes should override it to send all
+   * buffers in a single operation.
+   *
+   * \param buffers Buffers to send.
+   * \param count Number of buffers.
+   *
+   * \return Number of bytes sent across all buffers, or \c -1 on error with
+   *         \c errno set.
+   */
+  virtual ssize_t send_some_vectored(const struct iovec* buffers, int count);
+  /**
+   * \brief Receives part of a buffer.
+   *
+   * \param buffer Buffer to store received bytes into.
+   * \param size Maximum number of bytes to receive.
+   *
+   * \return Number of bytes received, \c 0 if the peer closed the connection,
+   *         or \c -1 on error with \c errno set.
+   */
+  virtual ssize_t recv_some(char* buffer, size_t size) = 0;
+
+  /**
+   * \brief Sends data to the connection.
+   *
+   * Repeatedly calls \ref send_some until the entire buffer has been sent,
+   * resuming after short writes, interrupts and \c EAGAIN.
+   *
+   * \param data Data to send.
+   *
+   * \return Success of sending data.
+   */
+  bool send_data(const std::vector<char>& data);
+  /**
+   * \brief Sends several buffers to the connection in order.
+   *
+   * Repeatedly calls \ref send_some_vectored until every buffer has been sent,
+   * resuming after short writes, interrupts and \c EAGAIN.
+   *
+   * \param buffers Buffers to send.
+   *
+   * \return Success of sending all buffers.
+   */
+  bool send_data(const std::vector<std::vector<char>>& buffers);
+  /**
+   * \brief Receive data from the connection.
+   *
+   * Repeatedly calls \ref recv_some in a blocking manner until \p buffer_size
+   * bytes have been received, resuming after short reads, interrupts and
+   * \c EAGAIN. An empty optional will be returned if an error occurred or the
+   * connection was closed.
+   *
+   * \param buffer_size Size of data to retrieve.
+   *
+   * \return Data from the connection if successful.
+   *
+   * \see recv_data(int,int)
+   */
+  std::optional<std::vector<char>> recv_data(int buffer_size);
+  /**
+   * \brief Receives data into an existing buffer.
+   *
+   * Same as \ref recv_data(int), without allocating.
+   *
+   * \param buffer Buffer to store received bytes into.
+   * \param size Number of bytes to receive.
+   *
+   * \return Success of receiving all \p size bytes.
+   */
+  bool recv_exact(char* buffer, size_t size);
+  /**
+   * \brief Receives and drops data.
+   *
+   * Reads in fixed chunks, so skipping data of any size uses constant memory.
+   *
+   * \param size Number of bytes to drop.
+   *
+   * \return Success of receiving all \p size bytes.
+   */
+  bool discard_data(size_t size);
+  /**
+   * \brief Receive data from the connection on timeout.
+   *
+   * Waits for data with \ref wait_readable before calling \ref recv_data(int).
+   * If the wait times out, then an empty optional will be returned.
+   *
+   * \param buffer_size Size of data to retrieve.
+   * \param timeout Time to wait in milliseconds.
+   *
+   * \return Data from the connection if existant.
+   *
+   * \see recv_data(int)
+   */
+  std::optional<std::vector<char>> recv_data(int buffer_size, int timeout);
+};
+}  // namespace discord_ipc_cpp::websockets
+
+#endif  // DISCORD_IPC_CPP_INCLUDE_DISCORD_IPC_CPP_TRANSPORT_HPP_
@@ -0,0 +1,257 @@
+/*
+  Copyright 2025 Peter Duanmu
+
+  You should have received a copy of the GNU General Public License along
+  with discord_ipc_cpp. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <utility>
+
+#include "discord_ipc_cpp/callback_executor.hpp"
+
+namespace discord_ipc_cpp::executors {
+namespace {
+thread_local bool non_blocking = false;
+}  // namespace
+
+NonBlockingScope::NonBlockingScope() : _previous(non_blocking) {
+  non_blocking = true;
+}
+
+NonBlockingScope::~NonBlockingScope() {
+  non_blocking = _previous;
+}
+
+bool NonBlockingScope::active() {
+  return non_blocking;
+}
+
+void InlineExecutor::execute(Task task, uint64_t) {
+  task();
+}
+
+BoundedTaskQueue::BoundedTaskQueue(size_t capacity, OverflowPolicy policy)
+: _capacity(std::max<size_t>(capacity, 1)),
+_policy(policy),
+_droppable(0),
+_closed(false),
+_dropped(0),
+_coalesced(0),
+_peak_required(0) {}
+
+bool BoundedTaskQueue::drop_oldest() {
+  auto it = std::find_if(_entries.begin(), _entries.end(), [](auto& entry) {
+    return entry.key != 0;
+  });
+
+  if (it == _entries.end()) {
+    return false;
+  }
+
+  _entries.erase(it);
+
+  --_droppable;
+  ++_dropped;
+
+  return true;
+}
+
+bool BoundedTaskQueue::push(Task task, uint64_t key) {
+  std::unique_lock<std::mutex> lock(_mutex);
+
+  if (_closed) {
+    return false;
+  }
+
+  // tasks that complete a request are never held back
+  if (key != 0) {
+    // tasks are only coalesced once the queue is full, so none are lost
+    // without backpressure
+    if (_policy == op_coalesce && _droppable >= _capacity) {
+      auto it = std::find_if(_entries.rbegin(), _entries.rend(),
+        [key](auto& entry) {
+          return entry.key == key;
+        });
+
+      if (it != _entries.rend()) {
+        it->task = std::move(task);
+
+        ++_coalesced;
+
+        return true;
+      }
+    }
+
+    if (_droppable >= _capacity) {
+      if (_policy == op_block && !non_blocking) {
+        _not_full.wait(lock, [this]() {
+          return _closed || _droppable < _capacity;
+        });
+
+        if (_closed) {
+          return false;
+        }
+      } else {
+        drop_oldest();
+      }
+    }
+
+    ++_droppable;
+  }
+
+  _entries.push_back({ .task = std::move(task), .key = key });
+
+  if (key == 0) {
+    _peak_required = std::max(_peak_required, _entries.size() - _droppable);
+  }
+
+  lock.unlock();
+
+  _not_empty.notify_one();
+
+  return true;
+}
+
+Task BoundedTaskQueue::pop(std::chrono::milliseconds timeout) {
+  std::unique_lock<std::mutex> lock(_mutex);
+
+  if (!_not_empty.wait_for(lock, timeout, [this]() {
+        return _closed || !_entries.empty();
+      }) || _entries.empty()) {
+    return nullptr;
+  }
+
+  Entry entry = std::move(_entries.front());
+
+  _entries.pop_front();
+
+  if (entry.key != 0) {
+    --_droppable;
+
+    lock.unlock();
+
+    _not_full.notify_one();
+  }
+
+  return std::move(entry.task);
+}
+
+void BoundedTaskQueue::close() {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    _closed = true;
+  }
+
+  _not_empty.notify_all();
+  _not_full.notify_all();
+}
+
+bool BoundedTaskQueue::is_closed() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  return _closed;
+}
+
+size_t BoundedTaskQueue::size() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  return _entries.size();
+}
+
+uint64_t BoundedTaskQueue::dropped() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  return _dropped;
+}
+
+uint64_t BoundedTaskQueue::coalesced() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  return _coalesced;
+}
+
+size_t BoundedTaskQueue::required() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  return _entries.size() - _droppable;
+}
+
+size_t BoundedTaskQueue::peak_required() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  return _peak_required;
+}
+
+QueueExecutor::QueueExecutor(size_t capacity, OverflowPolicy policy)
+: _queue(capacity, policy) {}
+
+void QueueExecutor::execute(Task task, uint64_t key) {
+  _queue.push(std::move(task), key);
+}
+
+size_t QueueExecutor::run_pending(
+  size_t max_tasks, std::chrono::milliseconds timeout
+) {
+  size_t ran = 0;
+
+  while (ran < max_tasks) {
+    Task task = _queue.pop(
+      ran == 0 ? timeout : std::chrono::milliseconds(0));
+
+    if (!task) {
+      break;
+    }
+
+    task();
+
+    ++ran;
+  }
+
+  return ran;
+}
+
+const BoundedTaskQueue& QueueExecutor::queue() const {
+  return _queue;
+}
+
+ThreadPoolExecutor::ThreadPoolExecutor(
+  size_t threads, size_t capacity, OverflowPolicy policy
+)
+: _queue(capacity, policy) {
+  for (size_t i = 0; i < std::max<size_t>(threads, 1); ++i) {
+    _workers.emplace_back(&ThreadPoolExecutor::worker, this);
+  }
+}
+
+ThreadPoolExecutor::~ThreadPoolExecutor() {
+  _queue.close();
+
+  for (auto& worker : _workers) {
+    worker.join();
+  }
+}
+
+void ThreadPoolExecutor::worker() {
+  while (true) {
+    Task task = _queue.pop(std::chrono::milliseconds(1000));
+
+    if (task) {
+      task();
+    } else if (_queue.is_closed()) {
+      return;
+    }
+  }
+}
+
+void ThreadPoolExecutor::execute(Task task, uint64_t key) {
+  _queue.push(std::move(task), key);
+}
+
+const BoundedTaskQueue& ThreadPoolExecutor::queue() const {
+  return _queue;
+}
+}  // namespace discord_ipc_cpp::executors
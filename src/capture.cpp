@@ -0,0 +1,358 @@
+/*
+  Copyright 2025 Peter Duanmu
+
+  You should have received a copy of the GNU General Public License along
+  with discord_ipc_cpp. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "discord_ipc_cpp/capture.hpp"
+
+namespace discord_ipc_cpp::capture {
+namespace {
+constexpr char magic[8] = { 'D', 'I', 'P', 'C', 'C', 'A', 'P', '1' };
+
+struct FileHeader {
+  char magic[8];
+  uint64_t size;
+  uint64_t head;
+  uint64_t tail;
+  uint64_t records;
+  uint64_t overwritten;
+  uint64_t reserved[2];
+};
+
+struct RecordHeader {
+  uint32_t size;
+  uint8_t direction;
+  uint8_t reserved[3];
+  int32_t opcode;
+  uint32_t length;
+  int64_t timestamp;
+};
+
+static_assert(sizeof(FileHeader) == 64);
+static_assert(sizeof(RecordHeader) == 24);
+
+constexpr size_t data_start = sizeof(FileHeader);
+constexpr size_t min_capacity = 4096;
+
+constexpr size_t align_record(size_t size) {
+  return (size + 7) & ~size_t { 7 };
+}
+
+// the ring wraps wherever a record header no longer fits or a marker was left
+bool wraps_at(const char* map, size_t size, size_t offset) {
+  if (size - offset < sizeof(RecordHeader)) {
+    return true;
+  }
+
+  uint32_t record_size;
+
+  std::memcpy(&record_size, map + offset, sizeof(record_size));
+
+  return record_size == 0;
+}
+}  // namespace
+
+CaptureWriter::CaptureWriter() : _fd(-1), _map(nullptr), _size(0) {}
+
+CaptureWriter::~CaptureWriter() {
+  close();
+}
+
+void CaptureWriter::drop_oldest() {
+  auto* header = reinterpret_cast<FileHeader*>(_map);
+
+  size_t tail = header->tail;
+
+  if (wraps_at(_map, _size, tail)) {
+    tail = data_start;
+  }
+
+  tail += reinterpret_cast<const RecordHeader*>(_map + tail)->size;
+
+  --header->records;
+  ++header->overwritten;
+
+  if (header->records == 0) {
+    tail = header->head;
+  } else if (wraps_at(_map, _size, tail)) {
+    tail = data_start;
+  }
+
+  header->tail = tail;
+}
+
+bool CaptureWriter::open(const std::string& path, size_t capacity) {
+  close();
+
+  capacity &= ~size_t { 7 };
+
+  if (capacity < min_capacity) {
+    return false;
+  }
+
+  int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+  if (fd < 0) {
+    return false;
+  }
+
+  if (::ftruncate(fd, capacity) != 0) {
+    ::close(fd);
+
+    return false;
+  }
+
+  void* map = ::mmap(
+    nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+  if (map == MAP_FAILED) {
+    ::close(fd);
+
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  _fd = fd;
+  _map = static_cast<char*>(map);
+  _size = capacity;
+
+  auto* header = reinterpret_cast<FileHeader*>(_map);
+
+  std::memcpy(header->magic, magic, sizeof(magic));
+  header->size = capacity;
+  header->head = data_start;
+  header->tail = data_start;
+  header->records = 0;
+  header->overwritten = 0;
+
+  return true;
+}
+
+void CaptureWriter::close() {
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  if (_map == nullptr) {
+    return;
+  }
+
+  ::msync(_map, _size, MS_SYNC);
+  ::munmap(_map, _size);
+  ::close(_fd);
+
+  _fd = -1;
+  _map = nullptr;
+  _size = 0;
+}
+
+bool CaptureWriter::is_open() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  return _map != nullptr;
+}
+
+bool CaptureWriter::record(
+  Direction direction, const char* frame, size_t size
+) {
+  if (size < 8) {
+    return false;
+  }
+
+  int64_t timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::system_clock::now().time_since_epoch()).count();
+
+  size_t length = size - 8;
+  size_t record_size = align_record(sizeof(RecordHeader) + length);
+
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  // bounding records to half the ring guarantees room can always be made
+  if (_map == nullptr || record_size > (_size - data_start) / 2) {
+    return false;
+  }
+
+  auto* header = reinterpret_cast<FileHeader*>(_map);
+
+  if (_size - header->head < record_size) {
+    // free the rest of the ring before wrapping over it
+    while (header->records > 0 && header->tail >= header->head) {
+      drop_oldest();
+    }
+
+    if (_size - header->head >= sizeof(uint32_t)) {
+      std::memset(_map + header->head, 0, sizeof(uint32_t));
+    }
+
+    header->head = data_start;
+
+    if (header->records == 0) {
+      header->tail = data_start;
+    }
+  }
+
+  while (header->records > 0 && header->tail >= header->head &&
+         header->tail < header->head + record_size) {
+    drop_oldest();
+  }
+
+  RecordHeader record {
+    .size = static_cast<uint32_t>(record_size),
+    .direction = direction,
+    .reserved = {},
+    .opcode = 0,
+    .length = static_cast<uint32_t>(length),
+    .timestamp = timestamp
+  };
+
+  std::memcpy(&record.opcode, frame, sizeof(record.opcode));
+
+  char* out = _map + header->head;
+
+  std::memcpy(out, &record, sizeof(record));
+  std::memcpy(out + sizeof(record), frame + 8, length);
+
+  if (header->records == 0) {
+    header->tail = header->head;
+  }
+
+  header->head += record_size;
+  ++header->records;
+
+  return true;
+}
+
+uint64_t CaptureWriter::records() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  return _map != nullptr
+    ? reinterpret_cast<const FileHeader*>(_map)->records
+    : 0;
+}
+
+uint64_t CaptureWriter::overwritten() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  return _map != nullptr
+    ? reinterpret_cast<const FileHeader*>(_map)->overwritten
+    : 0;
+}
+
+CaptureReader::CaptureReader() : _map(nullptr), _size(0), _overwritten(0) {}
+
+CaptureReader::~CaptureReader() {
+  close();
+}
+
+bool CaptureReader::open(const std::string& path) {
+  close();
+
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+  if (fd < 0) {
+    return false;
+  }
+
+  struct stat info;
+
+  if (::fstat(fd, &info) != 0 ||
+      static_cast<size_t>(info.st_size) < min_capacity) {
+    ::close(fd);
+
+    return false;
+  }
+
+  size_t size = info.st_size;
+  void* map = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+  ::close(fd);
+
+  if (map == MAP_FAILED) {
+    return false;
+  }
+
+  _map = static_cast<char*>(map);
+  _size = size;
+
+  FileHeader header;
+
+  std::memcpy(&header, _map, sizeof(header));
+
+  if (std::memcmp(header.magic, magic, sizeof(magic)) != 0 ||
+      header.size != size || header.tail < data_start ||
+      header.tail > size || header.records > size / sizeof(RecordHeader)) {
+    close();
+
+    return false;
+  }
+
+  _frames.reserve(header.records);
+
+  size_t offset = header.tail;
+
+  for (uint64_t i = 0; i < header.records; ++i) {
+    if (wraps_at(_map, _size, offset)) {
+      offset = data_start;
+    }
+
+    RecordHeader record;
+
+    std::memcpy(&record, _map + offset, sizeof(record));
+
+    if (record.size < sizeof(RecordHeader) || record.size % 8 != 0 ||
+        record.size > _size - offset ||
+        record.length > record.size - sizeof(RecordHeader)) {
+      close();
+
+      return false;
+    }
+
+    _frames.push_back({
+      .direction = static_cast<Direction>(record.direction),
+      .timestamp = record.timestamp,
+      .opcode = record.opcode,
+      .payload = std::string_view(
+        _map + offset + sizeof(RecordHeader), record.length)
+    });
+
+    offset += record.size;
+  }
+
+  _overwritten = header.overwritten;
+
+  return true;
+}
+
+void CaptureReader::close() {
+  if (_map != nullptr) {
+    ::munmap(_map, _size);
+  }
+
+  _map = nullptr;
+  _size = 0;
+  _overwritten = 0;
+
+  _frames.clear();
+}
+
+const std::vector<FrameRecord>& CaptureReader::frames() const {
+  return _frames;
+}
+
+uint64_t CaptureReader::overwritten() const {
+  return _overwritten;
+}
+}  // namespace discord_ipc_cpp::capture
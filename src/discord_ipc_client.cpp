@@ -7,18 +7,33 @@
 
 #include <unistd.h>
 
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <future>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <thread>
 #include <string>
+#include <string_view>
 #include <optional>
+#include <variant>
 #include <vector>
 #include <utility>
-#include <iostream>
 
 #include "discord_ipc_cpp/discord_ipc_client.hpp"
+#include "discord_ipc_cpp/capture.hpp"
 #include "discord_ipc_cpp/socket_client.hpp"
+#include "discord_ipc_cpp/transport.hpp"
 #include "discord_ipc_cpp/json.hpp"
+#include "discord_ipc_cpp/health_monitor.hpp"
+#include "discord_ipc_cpp/logger.hpp"
+#include "discord_ipc_cpp/metrics.hpp"
 #include "discord_ipc_cpp/parser.hpp"
+#include "discord_ipc_cpp/tracing.hpp"
 
 #include "include/internal_ipc_types.hpp"
 #include "include/utils.hpp"
@@ -29,13 +44,25 @@ using discord_ipc_cpp::json::JSONObject;
 using discord_ipc_cpp::json::JSONArray;
 using discord_ipc_cpp::json::Parser;
 
+using discord_ipc_cpp::ipc_types::CommandResponse;
 using discord_ipc_cpp::ipc_types::Opcode;
 using discord_ipc_cpp::ipc_types::Payload;
 using discord_ipc_cpp::ipc_types::RichPresence;
+using discord_ipc_cpp::ipc_types::SendResult;
 
 using discord_ipc_cpp::internal_ipc_types::AuthorizationRequest;
 using discord_ipc_cpp::internal_ipc_types::CommandRequest;
 
+std::vector<char> DiscordIPCClient::serialize_packet(
+  const Payload& payload
+) {
+  DISCORD_IPC_CPP_TRACE_SCOPE("encode_packet");
+
+  metrics::ScopedTimer timer(_metrics.timer(metrics::mt_serialize));
+
+  return encode_packet(payload);
+}
+
 std::vector<char> DiscordIPCClient::encode_packet(
   const Payload& payload
 ) {
@@ -51,32 +78,206 @@ std::vector<char> DiscordIPCClient::encode_packet(
   return packet;
 }
 
+size_t DiscordIPCClient::find_nonce(const std::vector<char>& packet) {
+  static constexpr std::string_view key = "\"nonce\":\"";
+
+  return std::search(packet.begin(), packet.end(), key.begin(), key.end()) -
+         packet.begin() + key.size();
+}
+
+std::vector<char> DiscordIPCClient::empty_presence_frame(
+  std::string* nonce
+) const {
+  std::vector<char> packet = _empty_presence_frame;
+
+  *nonce = next_nonce();
+
+  std::memcpy(
+    &packet[_empty_presence_nonce_offset], nonce->data(), nonce->size());
+
+  return packet;
+}
+
+std::string DiscordIPCClient::next_nonce() const {
+  if (_nonce_mode.load(std::memory_order_relaxed) != ipc_types::nm_counter) {
+    return utils::generate_uuid();
+  }
+
+  std::string nonce(utils::uuid_size, '\0');
+
+  utils::format_uuid(
+    _nonce_prefix,
+    _nonce_counter.fetch_add(1, std::memory_order_relaxed),
+    nonce.data());
+
+  return nonce;
+}
+
 void DiscordIPCClient::recv_thread() {
+  _recv_thread_id = std::this_thread::get_id();
+
+  // a full blocking executor must not stall heartbeats
+  executors::NonBlockingScope non_blocking;
+
+  std::unique_lock<std::mutex> lock(_recv_mutex);
+
+  while (true) {
+    _recv_cv.wait(lock, [this]() {
+      return _recv_exit || !_stop_recv_thread;
+    });
+
+    if (_recv_exit) {
+      break;
+    }
+
+    _recv_active = true;
+
+    lock.unlock();
+
+    serve_connection();
+
+    lock.lock();
+
+    _recv_active = false;
+
+    _recv_cv.notify_all();
+  }
+}
+
+bool DiscordIPCClient::on_recv_thread() const {
+  return std::this_thread::get_id() == _recv_thread_id.load();
+}
+
+void DiscordIPCClient::wait_recv_idle() {
+  std::unique_lock<std::mutex> lock(_recv_mutex);
+
+  _recv_cv.wait(lock, [this]() { return !_recv_active; });
+}
+
+void DiscordIPCClient::serve_connection() {
+  std::chrono::milliseconds timeout(1000);
+
   while (!_stop_recv_thread) {
-    auto optional_payload = recv_packet();
+    // a large frame may have grown the buffer, so release it between frames
+    if (_recv_buffer.capacity() > _max_buffered_bytes) {
+      std::vector<char>().swap(_recv_buffer);
+    }
+
+    std::vector<char>* frame = &_recv_buffer;
+    bool received = false;
+
+    if (_socket->is_connected()) {
+      received = recv_frame(timeout.count(), frame);
+
+      if (!received && !_socket->is_connected() &&
+          !_stop_recv_thread) {
+        health::HealthState previous = _health.status().state;
+
+        _logger.log<logging::ll_warning>([]() {
+          return std::string("socket connection lost");
+        });
+
+        _health.fail(Clock::now());
+
+        report_health(previous);
+      }
+    } else {
+      // nothing can be received until reconnected
+      std::unique_lock<std::mutex> lock(_recv_mutex);
 
-    if (!optional_payload.has_value()) {
+      _recv_cv.wait_for(lock, timeout, [this]() {
+        return _stop_recv_thread.load();
+      });
+    }
+
+    flush_outbound();
+
+    timeout = std::min({
+      expire_pending(),
+      expire_ready_waiters(),
+      flush_scheduled_presence(),
+      monitor_health()
+    });
+
+    if (!received) {
       continue;
     }
 
-    Payload recv_payload = std::move(*optional_payload);
+    int opcode;
 
-    std::cout << recv_payload.payload.to_string() << std::endl;
+    std::memcpy(&opcode, frame->data(), 4);
 
-    switch (recv_payload.opcode) {
-      case Opcode::op_ping:
-        send_packet({ Opcode::op_pong, recv_payload.payload });
+    _metrics.count_received(opcode, frame->size());
 
-        break;
+    // echo pings back as-is with only the opcode rewritten
+    if (opcode == Opcode::op_ping) {
+      int pong = Opcode::op_pong;
+
+      std::memcpy(frame->data(), &pong, 4);
+
+      // copied, as the lane takes ownership and the buffer is reused
+      submit_frame(Opcode::op_pong, *frame);
+
+      continue;
+    }
+
+    auto parse_start = Clock::now();
+
+    Payload recv_payload = {
+      static_cast<Opcode>(opcode),
+      Parser::parse(std::string(frame->begin() + 8, frame->end()))
+    };
+
+    _metrics.timer(metrics::mt_parse).record(Clock::now() - parse_start);
+
+    _logger.log<logging::ll_trace>([&]() {
+      return "received " + recv_payload.payload.to_string();
+    });
+
+    switch (recv_payload.opcode) {
       case Opcode::op_frame: {
           CommandRequest response = CommandRequest::from_json(
             recv_payload.payload);
 
-          if (response.cmd == CommandRequest::ct_dispatch) {
-            _successful_auth = true;
+          if (response.cmd == CommandRequest::ct_dispatch &&
+              response.evt.has_value()) {
+            if (response.evt == ipc_types::et_ready) {
+              on_ready();
+            }
+
+            dispatch_event(*response.evt, response.data.value_or(JSON()));
+          } else if (response.nonce.has_value()) {
+            CommandResponse result { .status = CommandResponse::rs_success };
+
+            if (response.evt == ipc_types::et_error) {
+              result.status = CommandResponse::rs_error;
+
+              if (response.data.has_value()) {
+                auto code = response.data->safe_at("code");
+                auto message = response.data->safe_at("message");
+
+                if (code.has_value() && code->is<int>()) {
+                  result.error_code = code->as<int>();
+                }
+
+                if (message.has_value() && message->is<std::string>()) {
+                  result.error_message = message->as<std::string>();
+                }
+              }
+            }
+
+            result.data = response.data;
+
+            resolve_pending(*response.nonce, std::move(result));
+          } else if (response.evt == ipc_types::et_error) {
+            dispatch_event(ipc_types::et_error, response.data.value_or(JSON()));
           }
         }
 
+        break;
+      case Opcode::op_pong:
+        acknowledge_probe(recv_payload.payload);
+
         break;
       case Opcode::op_close:
         close();
@@ -87,159 +288,1516 @@ void DiscordIPCClient::recv_thread() {
     }
   }
 
-  std::cout << "socket connection closed" << std::endl;
+  _logger.log<logging::ll_info>([]() {
+    return std::string("socket connection closed");
+  });
 }
 
-DiscordIPCClient::DiscordIPCClient(const std::string& client_id)
-: _pid(getpid()),
-_client_id(client_id),
-_socket(utils::find_discord_ipc_file()),
-_stop_recv_thread(false),
-_successful_auth(false) {}
+bool DiscordIPCClient::resolve_pending(
+  const std::string& nonce, CommandResponse response
+) {
+  PendingRequest request;
 
-DiscordIPCClient::~DiscordIPCClient() {
-  close();
+  {
+    std::lock_guard<std::mutex> lock(_pending_mutex);
+
+    auto it = _pending_requests.find(nonce);
+
+    if (it == _pending_requests.end()) {
+      return false;
+    }
+
+    request = std::move(it->second);
+
+    _pending_requests.erase(it);
+  }
+
+  response.round_trip = Clock::now() - request.sent_at;
+
+  if (response.status == CommandResponse::rs_success ||
+      response.status == CommandResponse::rs_error) {
+    _metrics.timer(metrics::mt_round_trip).record(response.round_trip);
+  }
+
+  DISCORD_IPC_CPP_TRACE_SINCE("reply", request.sent_at, request.trace_request);
+
+  request.callback(response);
+
+  return true;
 }
 
-bool DiscordIPCClient::send_packet(const Payload& payload) {
-  if (payload.opcode != Opcode::op_handshake &&
-      payload.opcode != Opcode::op_close &&
-      !_successful_auth) {
-    return false;
+std::chrono::milliseconds DiscordIPCClient::expire_pending() {
+  std::vector<std::string> expired;
+  std::chrono::milliseconds next_deadline(1000);
+
+  {
+    std::lock_guard<std::mutex> lock(_pending_mutex);
+
+    auto now = Clock::now();
+
+    while (!_pending_deadlines.empty()) {
+      const auto& [deadline, nonce] = _pending_deadlines.top();
+
+      if (deadline > now) {
+        next_deadline = std::min(
+          next_deadline,
+          std::chrono::ceil<std::chrono::milliseconds>(deadline - now));
+
+        break;
+      }
+
+      if (_pending_requests.contains(nonce)) {
+        expired.push_back(nonce);
+      }
+
+      _pending_deadlines.pop();
+    }
   }
 
-  std::vector<char> packet = encode_packet(payload);
+  for (const auto& nonce : expired) {
+    resolve_pending(nonce, {
+      .status = CommandResponse::rs_timeout,
+      .error_message = "timed out waiting for reply"
+    });
+  }
 
-  return _socket.send_data(packet);
+  return next_deadline;
 }
 
-std::optional<Payload> DiscordIPCClient::recv_packet() {
-  int opcode, data_len;
-  std::string data;
-  std::vector<char> opcode_buffer(4), data_len_buffer(4), buffer;
+std::vector<DiscordIPCClient::PendingRequest>
+DiscordIPCClient::take_pending() {
+  std::vector<PendingRequest> pending;
 
-  auto poll_buffer = _socket.recv_data(4, 1000);
+  std::lock_guard<std::mutex> lock(_pending_mutex);
 
-  if (!poll_buffer.has_value()) {
-    return std::nullopt;
+  pending.reserve(_pending_requests.size());
+
+  for (auto& [nonce, request] : _pending_requests) {
+    pending.push_back(std::move(request));
+  }
+
+  // clearing keeps the buckets for the next connection
+  _pending_requests.clear();
+  _pending_deadlines = {};
+
+  return pending;
+}
+
+void DiscordIPCClient::fail_pending(
+  std::vector<PendingRequest> pending, CommandResponse::Status status,
+  const std::string& reason
+) {
+  for (auto& request : pending) {
+    request.callback({
+      .status = status,
+      .error_message = reason,
+      .round_trip = Clock::now() - request.sent_at
+    });
   }
+}
+
+SendResult DiscordIPCClient::send_scheduled_presence(
+  const Payload& payload, uint64_t sequence
+) {
+  return send_command_frame(
+    payload.payload["nonce"].as<std::string>(),
+    serialize_packet(payload),
+    [this, sequence](const CommandResponse& response) {
+      acknowledge_presence(response, sequence);
+    },
+    std::chrono::seconds(5));
+}
+
+std::chrono::milliseconds DiscordIPCClient::flush_scheduled_presence() {
+  std::lock_guard<std::mutex> lock(_presence_flush_mutex);
 
-  opcode_buffer = std::move(*poll_buffer);
+  if (_successful_auth) {
+    uint64_t sequence;
+    auto payload = _presence_scheduler.poll(Clock::now(), &sequence);
 
-  data_len_buffer = std::move(*_socket.recv_data(4));
+    if (payload.has_value()) {
+      SendResult result = send_scheduled_presence(*payload, sequence);
 
-  std::memcpy(&opcode, opcode_buffer.data(), opcode_buffer.size());
-  std::memcpy(&data_len, data_len_buffer.data(), data_len_buffer.size());
+      if (result == ipc_types::sr_backpressure ||
+          result == ipc_types::sr_closed) {
+        _presence_scheduler.restore(*payload, sequence);
 
-  buffer.resize(data_len);
+        _metrics.increment(metrics::mc_retries);
+      }
+    }
+  }
 
-  buffer = std::move(*_socket.recv_data(data_len));
+  auto next_release = _presence_scheduler.next_release(Clock::now());
 
-  data = std::string(buffer.begin(), buffer.end());
+  if (!next_release.has_value()) {
+    return std::chrono::milliseconds(1000);
+  }
 
-  return Payload {
-    static_cast<Opcode>(opcode),
-    Parser::parse(data)
-  };
+  return std::min(
+    std::chrono::milliseconds(1000),
+    std::chrono::ceil<std::chrono::milliseconds>(*next_release));
 }
 
-Payload DiscordIPCClient::construct_presence_payload(
-  const std::optional<RichPresence>& presence) {
-    std::map<std::string, CommandRequest::RequestArgs> args = {
-      { "pid", _pid }
-    };
+std::chrono::milliseconds DiscordIPCClient::monitor_health() {
+  auto now = Clock::now();
+  health::HealthState previous = _health.status().state;
 
-    if (presence.has_value()) {
-      args.insert({ "activity", presence.value() });
+  if (_stop_recv_thread) {
+    return std::chrono::milliseconds(1000);
+  }
+
+  if (_health.should_reconnect(now)) {
+    reconnect();
+  } else if (_socket->is_connected()) {
+    auto probe = _health.poll(now);
+
+    if (probe.has_value()) {
+      submit_frame(Opcode::op_ping, encode_packet({
+        .opcode = Opcode::op_ping,
+        .payload = JSON(JSONObject {
+          { "nonce", JSON(std::to_string(*probe)) }
+        })
+      }));
     }
+  }
 
-    Payload payload = {
-      .opcode = Opcode::op_frame,
-      .payload = CommandRequest {
-        .cmd = CommandRequest::ct_set_activity,
-        .nonce = utils::generate_uuid(),
-        .args = args
-      }.to_json()
-    };
+  report_health(previous);
 
-  return payload;
+  auto next_due = _health.next_due(Clock::now());
+
+  if (!next_due.has_value()) {
+    return std::chrono::milliseconds(1000);
+  }
+
+  return std::min(
+    std::chrono::milliseconds(1000),
+    std::chrono::ceil<std::chrono::milliseconds>(*next_due));
 }
 
-bool DiscordIPCClient::attempt_send_payload(
-  const ipc_types::Payload& payload,
-  int max_retry_count
-) {
-  bool success;
-  int retry_count = 0;
+void DiscordIPCClient::acknowledge_probe(const JSON& data) {
+  auto nonce = data.safe_at("nonce");
 
-  do {
-    success = send_packet(payload);
+  if (!nonce.has_value() || !nonce->is<std::string>()) {
+    return;
+  }
 
-    if (!success) {
-      std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+  std::string value = nonce->as<std::string>();
+  uint64_t probe = 0;
 
-      ++retry_count;
-    }
-  } while (!success && retry_count <= max_retry_count);
+  std::from_chars(value.data(), value.data() + value.size(), probe);
 
-  return success;
+  health::HealthState previous = _health.status().state;
+  auto round_trip = _health.acknowledge(probe, Clock::now());
+
+  if (round_trip.has_value()) {
+    _metrics.timer(metrics::mt_heartbeat).record(*round_trip);
+  }
+
+  report_health(previous);
 }
 
+void DiscordIPCClient::report_health(health::HealthState previous) {
+  health::HealthStatus status = _health.status();
 
-bool DiscordIPCClient::connect() {
-  bool ret = _socket.connect();
+  if (status.state == previous) {
+    return;
+  }
 
-  if (!ret) {
-    return false;
+  _logger.log<logging::ll_info>([&]() {
+    return "connection health changed from " + std::to_string(previous) +
+           " to " + std::to_string(status.state);
+  });
+
+  HealthHandler handler;
+
+  {
+    std::lock_guard<std::mutex> lock(_health_mutex);
+
+    handler = _health_handler;
   }
 
-  ret = send_packet({
-    .opcode = Opcode::op_handshake,
-    .payload = AuthorizationRequest {
-      .version = "1",
-      .client_id = _client_id
-    }.to_json()
+  if (handler) {
+    handler(previous, status);
+  }
+}
+
+bool DiscordIPCClient::reconnect() {
+  std::vector<PendingRequest> pending;
+  bool reconnected;
+
+  {
+    // a closure in progress waits for this thread, so never wait for it
+    std::unique_lock<std::mutex> lifecycle(
+      _lifecycle_mutex, std::try_to_lock);
+
+    if (!lifecycle.owns_lock() || _stop_recv_thread) {
+      return false;
+    }
+
+    reconnected = reopen_connection(&pending);
+  }
+
+  fail_pending(std::move(pending), CommandResponse::rs_closed,
+               "connection lost");
+
+  return reconnected;
+}
+
+bool DiscordIPCClient::reopen_connection(
+  std::vector<PendingRequest>* pending
+) {
+  _logger.log<logging::ll_warning>([]() {
+    return std::string("reconnecting dead connection");
   });
 
-  if (!ret) {
+  _state = ipc_types::cs_connecting;
+
+  {
+    std::lock_guard<std::mutex> lock(_ready_mutex);
+
+    _successful_auth = false;
+  }
+
+  _subscribed_events = 0;
+
+  bool connected;
+
+  {
+    // nothing may be written while the connection is replaced
+    std::lock_guard<std::mutex> lock(_write_mutex);
+    std::vector<std::vector<char>> discarded;
+
+    drain_lane(_control_lane, &discarded, SIZE_MAX);
+    drain_lane(_normal_lane, &discarded, SIZE_MAX);
+
+    _socket->close();
+
+    connected = _socket->connect();
+  }
+
+  *pending = take_pending();
+
+  reset_presence_state();
+
+  if (!connected) {
     return false;
   }
 
-  _socket_recv_thread = std::thread { &DiscordIPCClient::recv_thread, this };
+  _connected_at = Clock::now();
 
-  struct sched_param sch_params;
-  sch_params.sched_priority = 0;
+  _health.reset(_connected_at);
 
-  pthread_setschedparam(
-    _socket_recv_thread.native_handle(), SCHED_OTHER, &sch_params);
+  if (submit_frame(Opcode::op_handshake, _handshake_frame) !=
+      ipc_types::sr_accepted) {
+    _health.fail(Clock::now());
 
-  _socket_recv_thread.detach();
+    return false;
+  }
+
+  if (_metrics.increment(metrics::mc_connects) > 1) {
+    _metrics.increment(metrics::mc_reconnects);
+  }
 
   return true;
 }
 
-bool DiscordIPCClient::close() {
-  send_packet({
-    .opcode = Opcode::op_close,
-    .payload = {}
-  });
+void DiscordIPCClient::reset_presence_state() {
+  std::lock_guard<std::mutex> lock(_presence_state_mutex);
+
+  _last_presence = std::nullopt;
+  _presence_sequence = 0;
+  _acknowledged_sequence = 0;
+}
 
-  _stop_recv_thread = true;
+void DiscordIPCClient::on_ready() {
+  std::vector<std::pair<Clock::time_point, ReadyCallback>> waiters;
 
-  std::this_thread::sleep_for(std::chrono::milliseconds(25));
+  {
+    std::lock_guard<std::mutex> lock(_ready_mutex);
 
-  return _socket.close();
+    _successful_auth = true;
+
+    waiters.swap(_ready_waiters);
+  }
+
+  auto connecting = ipc_types::cs_connecting;
+
+  _state.compare_exchange_strong(connecting, ipc_types::cs_ready);
+
+  DISCORD_IPC_CPP_TRACE_SINCE("await_ready", _connected_at, 0);
+
+  flush_outbound();
+
+  _ready_cv.notify_all();
+
+  for (size_t type = 0; type < ipc_types::event_type_count; ++type) {
+    std::vector<ResponseCallback> acks;
+
+    {
+      std::lock_guard<std::mutex> lock(_event_mutex);
+
+      if (_event_handlers[type] == nullptr) {
+        continue;
+      }
+
+      acks.swap(_subscribe_acks[type]);
+    }
+
+    send_subscribe(
+      static_cast<ipc_types::EventType>(type),
+      [acks = std::move(acks)](const CommandResponse& response) {
+        for (const auto& ack : acks) {
+          ack(response);
+        }
+      });
+  }
+
+  for (auto& [deadline, callback] : waiters) {
+    callback(true);
+  }
 }
 
-bool DiscordIPCClient::set_presence(const ipc_types::RichPresence& presence) {
-  Payload payload = construct_presence_payload(presence);
+void DiscordIPCClient::add_ready_waiter(
+  ReadyCallback callback, std::chrono::milliseconds timeout
+) {
+  {
+    std::lock_guard<std::mutex> lock(_ready_mutex);
+
+    if (!_successful_auth) {
+      _ready_waiters.emplace_back(Clock::now() + timeout, std::move(callback));
 
-  return attempt_send_payload(payload, 3);
+      return;
+    }
+  }
+
+  callback(true);
 }
 
-bool DiscordIPCClient::set_empty_presence() {
-  Payload payload = construct_presence_payload({});
+std::chrono::milliseconds DiscordIPCClient::expire_ready_waiters() {
+  std::vector<ReadyCallback> expired;
+  std::chrono::milliseconds next_deadline(1000);
+
+  {
+    std::lock_guard<std::mutex> lock(_ready_mutex);
+
+    auto now = Clock::now();
+
+    std::erase_if(_ready_waiters, [&](auto& waiter) {
+      if (waiter.first > now) {
+        next_deadline = std::min(
+          next_deadline,
+          std::chrono::ceil<std::chrono::milliseconds>(waiter.first - now));
+
+        return false;
+      }
+
+      expired.push_back(std::move(waiter.second));
+
+      return true;
+    });
+  }
+
+  for (auto& callback : expired) {
+    callback(false);
+  }
+
+  return next_deadline;
+}
+
+void DiscordIPCClient::add_event_handler(
+  ipc_types::EventType type,
+  EventHandler handler,
+  ResponseCallback on_subscribed
+) {
+  on_subscribed = on_executor(std::move(on_subscribed));
+
+  {
+    std::lock_guard<std::mutex> lock(_event_mutex);
+
+    auto handlers = _event_handlers[type] != nullptr
+      ? std::make_shared<std::vector<EventHandler>>(*_event_handlers[type])
+      : std::make_shared<std::vector<EventHandler>>();
+
+    handlers->push_back(std::move(handler));
+
+    _event_handlers[type] = std::move(handlers);
+  }
+
+  if (!needs_subscribe(type) ||
+      (_subscribed_events.load() & (1u << type))) {
+    if (on_subscribed) {
+      on_subscribed({ .status = CommandResponse::rs_success });
+    }
+  } else if (!_successful_auth || !send_subscribe(type, on_subscribed)) {
+    std::lock_guard<std::mutex> lock(_event_mutex);
+
+    if (on_subscribed) {
+      _subscribe_acks[type].push_back(std::move(on_subscribed));
+    }
+  }
+}
 
-  return attempt_send_payload(payload, 3);
+bool DiscordIPCClient::needs_subscribe(ipc_types::EventType type) {
+  // ready and error are always dispatched
+  return type != ipc_types::et_ready && type != ipc_types::et_error;
+}
+
+bool DiscordIPCClient::send_subscribe(
+  ipc_types::EventType type, ResponseCallback on_subscribed
+) {
+  if (!needs_subscribe(type)) {
+    return false;
+  }
+
+  if (_subscribed_events.fetch_or(1u << type) & (1u << type)) {
+    return false;
+  }
+
+  send_command({
+    .opcode = Opcode::op_frame,
+    .payload = CommandRequest {
+      .cmd = CommandRequest::ct_subscribe,
+      .nonce = next_nonce(),
+      .args = std::nullopt,
+      .data = std::nullopt,
+      .evt = type
+    }.to_json()
+  },
+  on_subscribed ? std::move(on_subscribed) : [](const CommandResponse&) {},
+  std::chrono::seconds(5));
+
+  return true;
+}
+
+void DiscordIPCClient::dispatch_event(
+  ipc_types::EventType type, const JSON& data
+) {
+  if (static_cast<size_t>(type) >= ipc_types::event_type_count) {
+    return;
+  }
+
+  std::shared_ptr<const std::vector<EventHandler>> handlers;
+
+  {
+    std::lock_guard<std::mutex> lock(_event_mutex);
+
+    handlers = _event_handlers[type];
+  }
+
+  if (handlers == nullptr) {
+    return;
+  }
+
+  // events of the same type may be coalesced under backpressure
+  executor()->execute([handlers = std::move(handlers), data]() {
+    for (const auto& handler : *handlers) {
+      handler(data);
+    }
+  }, static_cast<uint64_t>(type) + 1);
+}
+
+std::shared_ptr<executors::CallbackExecutor> DiscordIPCClient::executor() {
+  std::lock_guard<std::mutex> lock(_executor_mutex);
+
+  return _executor;
+}
+
+DiscordIPCClient::DiscordIPCClient(const std::string& client_id)
+: DiscordIPCClient(
+    client_id,
+    std::make_unique<websockets::SocketClient>(
+      utils::find_discord_ipc_file())) {}
+
+DiscordIPCClient::DiscordIPCClient(
+  const std::string& client_id,
+  std::unique_ptr<websockets::Transport> transport)
+: _pid(getpid()),
+_client_id(client_id),
+_nonce_mode(ipc_types::nm_uuid),
+_nonce_prefix(utils::random_u64()),
+_nonce_counter(0),
+_handshake_frame(encode_packet({
+  .opcode = Opcode::op_handshake,
+  .payload = AuthorizationRequest {
+    .version = "1",
+    .client_id = _client_id
+  }.to_json()
+})),
+_close_frame(encode_packet({ .opcode = Opcode::op_close, .payload = {} })),
+_empty_presence_frame(encode_packet(construct_presence_payload({}))),
+_empty_presence_nonce_offset(find_nonce(_empty_presence_frame)),
+_socket(std::move(transport)),
+_stop_recv_thread(true),
+_state(ipc_types::cs_idle),
+_recv_active(false),
+_recv_exit(false),
+_successful_auth(false),
+_control_lane(64),
+_normal_lane(1024),
+_outbound_budget(1 << 20),
+_max_frame_size(ipc_types::FrameLimits {}.max_frame_size),
+_max_buffered_bytes(ipc_types::FrameLimits {}.max_buffered_bytes),
+_capturing(false),
+_presence_scheduler(5, std::chrono::seconds(20)),
+_presence_sequence(0),
+_acknowledged_sequence(0),
+_executor(std::make_shared<executors::InlineExecutor>()),
+_subscribed_events(0),
+_health(health::HealthPolicy {}) {}
+
+DiscordIPCClient::~DiscordIPCClient() {
+  // the receive thread would go on running on this client once freed, and a
+  // thread cannot join itself, so there is no safe way to continue
+  if (on_recv_thread()) {
+    _logger.log<logging::ll_error>([]() {
+      return std::string("client destroyed from its own receive thread");
+    });
+
+    std::terminate();
+  }
+
+  close();
+
+  {
+    std::lock_guard<std::mutex> lock(_recv_mutex);
+
+    _recv_exit = true;
+  }
+
+  _recv_cv.notify_all();
+
+  if (_socket_recv_thread.joinable()) {
+    _socket_recv_thread.join();
+  }
+}
+
+bool DiscordIPCClient::send_packet(const Payload& payload) {
+  SendResult result = submit_packet(payload);
+
+  return result == ipc_types::sr_accepted || result == ipc_types::sr_held;
+}
+
+SendResult DiscordIPCClient::submit_packet(const Payload& payload) {
+  return submit_frame(payload.opcode, serialize_packet(payload));
+}
+
+SendResult DiscordIPCClient::submit_frame(
+  Opcode opcode, std::vector<char> packet
+) {
+  if (!_socket->is_connected()) {
+    _metrics.increment(metrics::mc_dropped_updates);
+
+    return ipc_types::sr_closed;
+  }
+
+  bool control = opcode == Opcode::op_handshake ||
+                 opcode == Opcode::op_ping ||
+                 opcode == Opcode::op_pong ||
+                 opcode == Opcode::op_close;
+  OutboundLane& lane = control ? _control_lane : _normal_lane;
+  size_t size = packet.size();
+
+  // control packets are tiny and must never be refused for budget
+  if (lane.bytes.fetch_add(size) + size > _outbound_budget && !control) {
+    lane.bytes.fetch_sub(size);
+    ++lane.rejected;
+
+    _metrics.increment(metrics::mc_dropped_updates);
+
+    return ipc_types::sr_backpressure;
+  }
+
+  if (!lane.frames.try_push(std::move(packet))) {
+    lane.bytes.fetch_sub(size);
+    ++lane.rejected;
+
+    _metrics.increment(metrics::mc_dropped_updates);
+
+    return ipc_types::sr_backpressure;
+  }
+
+  ++lane.submitted;
+
+  if (!control && !_successful_auth) {
+    return ipc_types::sr_held;
+  }
+
+  // the handshake and closure must be written before returning
+  bool wait = opcode != Opcode::op_ping && opcode != Opcode::op_pong &&
+              control;
+
+  return flush_outbound(wait) ? ipc_types::sr_accepted : ipc_types::sr_closed;
+}
+
+size_t DiscordIPCClient::drain_lane(
+  OutboundLane& lane, std::vector<std::vector<char>>* batch, size_t limit
+) {
+  size_t bytes = 0;
+  std::vector<char> packet;
+
+  while (batch->size() < limit && lane.frames.try_pop(&packet)) {
+    bytes += packet.size();
+
+    batch->push_back(std::move(packet));
+  }
+
+  lane.bytes.fetch_sub(bytes);
+
+  return bytes;
+}
+
+bool DiscordIPCClient::flush_outbound(bool wait) {
+  // bounds a single gathered write
+  static constexpr size_t max_batch = 64;
+
+  bool success = true;
+
+  // pairs with the fence after unlocking, so a writer that is just finishing
+  // sees this thread's packet. The receive thread also flushes on every
+  // iteration in case the lock could not be taken anyway
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  while (wait || _control_lane.frames.has_ready() ||
+         (_successful_auth && _normal_lane.frames.has_ready())) {
+    std::unique_lock<std::mutex> lock(_write_mutex, std::defer_lock);
+
+    if (wait) {
+      lock.lock();
+
+      wait = false;
+    } else if (!lock.try_lock()) {
+      break;
+    }
+
+    std::vector<std::vector<char>> batch;
+
+    while (true) {
+      batch.clear();
+
+      drain_lane(_control_lane, &batch, max_batch);
+
+      size_t control_count = batch.size();
+
+      if (_successful_auth) {
+        drain_lane(_normal_lane, &batch, max_batch);
+      }
+
+      if (batch.empty()) {
+        break;
+      }
+
+      auto write_start = Clock::now();
+      bool written = _socket->send_data(batch);
+
+      DISCORD_IPC_CPP_TRACE_SINCE("send_data", write_start, 0);
+
+      _metrics.timer(metrics::mt_socket_write).record(
+        Clock::now() - write_start);
+
+      if (written) {
+        _control_lane.written += control_count;
+        _normal_lane.written += batch.size() - control_count;
+
+        capture_frames(capture::cd_outbound, batch.data(), batch.size());
+
+        for (const auto& frame : batch) {
+          int frame_opcode;
+
+          std::memcpy(&frame_opcode, frame.data(), 4);
+
+          _metrics.count_sent(frame_opcode, frame.size());
+        }
+      } else {
+        success = false;
+
+        _logger.log<logging::ll_warning>([&]() {
+          return "failed to write " + std::to_string(batch.size()) +
+                 " frames";
+        });
+      }
+    }
+
+    lock.unlock();
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+  }
+
+  return success;
+}
+
+bool DiscordIPCClient::recv_frame(int timeout, std::vector<char>* frame) {
+  char header[8];
+
+  if (!_socket->wait_readable(timeout) || !_socket->recv_exact(header, 8)) {
+    return false;
+  }
+
+  int opcode;
+  int32_t data_len;
+
+  std::memcpy(&opcode, header, 4);
+  std::memcpy(&data_len, header + 4, 4);
+
+  if (opcode < 0 || static_cast<size_t>(opcode) >= metrics::opcode_count ||
+      data_len < 0) {
+    _metrics.increment(metrics::mc_malformed_frames);
+
+    _logger.log<logging::ll_error>([&]() {
+      return "closing connection after malformed frame header with opcode " +
+             std::to_string(opcode) + " and length " +
+             std::to_string(data_len);
+    });
+
+    // frame boundaries are lost, so nothing more can be read
+    std::lock_guard<std::mutex> lock(_write_mutex);
+
+    _socket->close();
+
+    return false;
+  }
+
+  if (static_cast<size_t>(data_len) > _max_frame_size) {
+    _metrics.increment(metrics::mc_oversized_frames);
+
+    _logger.log<logging::ll_warning>([&]() {
+      return "discarding oversized frame of " + std::to_string(data_len) +
+             " bytes with opcode " + std::to_string(opcode);
+    });
+
+    // a partly drained frame would be misread as the next header
+    if (!_socket->discard_data(data_len)) {
+      std::lock_guard<std::mutex> lock(_write_mutex);
+
+      _socket->close();
+    }
+
+    return false;
+  }
+
+  frame->resize(8 + data_len);
+
+  std::memcpy(frame->data(), header, 8);
+
+  if (!_socket->recv_exact(frame->data() + 8, data_len)) {
+    return false;
+  }
+
+  capture_frames(capture::cd_inbound, frame, 1);
+
+  return true;
+}
+
+void DiscordIPCClient::capture_frames(
+  capture::Direction direction, const std::vector<char>* frames, size_t count
+) {
+  if (!_capturing) {
+    return;
+  }
+
+  std::shared_ptr<capture::CaptureWriter> capture;
+
+  {
+    std::lock_guard<std::mutex> lock(_capture_mutex);
+
+    capture = _capture;
+  }
+
+  if (capture == nullptr) {
+    return;
+  }
+
+  for (size_t i = 0; i < count; ++i) {
+    capture->record(direction, frames[i].data(), frames[i].size());
+  }
+}
+
+std::optional<Payload> DiscordIPCClient::recv_packet(int timeout) {
+  std::vector<char> frame;
+
+  if (!recv_frame(timeout, &frame)) {
+    return std::nullopt;
+  }
+
+  int opcode;
+
+  std::memcpy(&opcode, frame.data(), 4);
+
+  return Payload {
+    static_cast<Opcode>(opcode),
+    Parser::parse(std::string(frame.begin() + 8, frame.end()))
+  };
+}
+
+Payload DiscordIPCClient::construct_presence_payload(
+  const std::optional<RichPresence>& presence) {
+    DISCORD_IPC_CPP_TRACE_SCOPE("construct_presence_payload");
+
+    std::map<std::string, CommandRequest::RequestArgs> args = {
+      { "pid", _pid }
+    };
+
+    if (presence.has_value()) {
+      args.insert({ "activity", presence.value() });
+    }
+
+    CommandRequest request {
+      .cmd = CommandRequest::ct_set_activity,
+      .nonce = next_nonce(),
+      .args = args
+    };
+
+    DISCORD_IPC_CPP_TRACE_SCOPE("to_json");
+
+    Payload payload = {
+      .opcode = Opcode::op_frame,
+      .payload = request.to_json()
+    };
+
+  return payload;
+}
+
+void DiscordIPCClient::send_command(
+  const Payload& payload,
+  ResponseCallback callback,
+  std::chrono::milliseconds timeout
+) {
+  send_command_frame(
+    payload.payload["nonce"].as<std::string>(),
+    serialize_packet(payload),
+    std::move(callback),
+    timeout);
+}
+
+SendResult DiscordIPCClient::send_command_frame(
+  const std::string& nonce,
+  std::vector<char> packet,
+  ResponseCallback callback,
+  std::chrono::milliseconds timeout
+) {
+  {
+    std::lock_guard<std::mutex> lock(_pending_mutex);
+
+    _pending_requests[nonce] = {
+      .callback = std::move(callback),
+      .sent_at = Clock::now(),
+      .trace_request = tracing::current_request()
+    };
+
+    _pending_deadlines.emplace(Clock::now() + timeout, nonce);
+  }
+
+  SendResult result = submit_frame(Opcode::op_frame, std::move(packet));
+
+  if (result == ipc_types::sr_backpressure) {
+    resolve_pending(nonce, {
+      .status = CommandResponse::rs_backpressure,
+      .error_message = "outbound byte budget exceeded"
+    });
+  } else if (result == ipc_types::sr_closed) {
+    resolve_pending(nonce, {
+      .status = CommandResponse::rs_closed,
+      .error_message = "failed to send command"
+    });
+  }
+
+  return result;
+}
+
+bool DiscordIPCClient::is_current_presence(
+  const std::optional<RichPresence>& presence
+) {
+  std::lock_guard<std::mutex> lock(_presence_state_mutex);
+
+  auto last = std::get_if<std::optional<RichPresence>>(&_last_presence);
+
+  if (_presence_sequence == 0 ||
+      _acknowledged_sequence != _presence_sequence ||
+      last == nullptr || *last != presence) {
+    return false;
+  }
+
+  _metrics.increment(metrics::mc_deduplicated_updates);
+
+  return true;
+}
+
+bool DiscordIPCClient::is_current_presence(
+  const TemplatedPresence& presence
+) {
+  std::lock_guard<std::mutex> lock(_presence_state_mutex);
+
+  auto last = std::get_if<TemplatedPresence>(&_last_presence);
+
+  if (_presence_sequence == 0 ||
+      _acknowledged_sequence != _presence_sequence ||
+      last == nullptr || *last != presence) {
+    return false;
+  }
+
+  _metrics.increment(metrics::mc_deduplicated_updates);
+
+  return true;
+}
+
+uint64_t DiscordIPCClient::track_presence(SubmittedPresence presence) {
+  std::lock_guard<std::mutex> lock(_presence_state_mutex);
+
+  _last_presence = std::move(presence);
+
+  return ++_presence_sequence;
+}
+
+void DiscordIPCClient::acknowledge_presence(
+  const CommandResponse& response, uint64_t sequence
+) {
+  if (response.status != CommandResponse::rs_success) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(_presence_state_mutex);
+
+  // a newer presence may already be on its way
+  if (sequence == _presence_sequence) {
+    _acknowledged_sequence = sequence;
+  }
+}
+
+SendResult DiscordIPCClient::submit_presence(
+  const std::optional<RichPresence>& presence,
+  ResponseCallback callback,
+  std::chrono::milliseconds timeout
+) {
+  std::string nonce;
+  std::vector<char> packet;
+
+  if (presence.has_value()) {
+    Payload payload = construct_presence_payload(presence);
+
+    nonce = payload.payload["nonce"].as<std::string>();
+    packet = serialize_packet(payload);
+  } else {
+    packet = empty_presence_frame(&nonce);
+  }
+
+  return submit_presence_frame(
+    presence, nonce, std::move(packet), std::move(callback), timeout);
+}
+
+SendResult DiscordIPCClient::submit_presence(
+  const ipc_types::PresenceTemplate& presence_template,
+  const ipc_types::PresenceUpdate& update,
+  ResponseCallback callback,
+  std::chrono::milliseconds timeout
+) {
+  std::string nonce = next_nonce();
+  std::vector<char> packet;
+
+  {
+    DISCORD_IPC_CPP_TRACE_SCOPE("render_template");
+
+    metrics::ScopedTimer timer(_metrics.timer(metrics::mt_serialize));
+
+    packet = presence_template.render(update, nonce);
+  }
+
+  return submit_presence_frame(
+    TemplatedPresence { presence_template.id(), update },
+    nonce,
+    std::move(packet),
+    std::move(callback),
+    timeout);
+}
+
+SendResult DiscordIPCClient::submit_presence_frame(
+  SubmittedPresence presence,
+  const std::string& nonce,
+  std::vector<char> packet,
+  ResponseCallback callback,
+  std::chrono::milliseconds timeout
+) {
+  uint64_t sequence = track_presence(std::move(presence));
+
+  return send_command_frame(
+    nonce,
+    std::move(packet),
+    [this, sequence, callback = std::move(callback)](
+      const CommandResponse& response
+    ) {
+      acknowledge_presence(response, sequence);
+
+      if (callback) {
+        callback(response);
+      }
+    },
+    timeout);
+}
+
+bool DiscordIPCClient::connect() {
+  bool on_receiver = on_recv_thread();
+  std::unique_lock<std::mutex> lifecycle(_lifecycle_mutex, std::defer_lock);
+
+  // a closure in progress waits for the receive thread, so it never waits
+  if (!on_receiver) {
+    lifecycle.lock();
+  } else if (!lifecycle.try_lock()) {
+    return false;
+  }
+
+  auto state = _state.load();
+
+  if (state == ipc_types::cs_connecting || state == ipc_types::cs_ready) {
+    return true;
+  }
+
+  // a closure from the receive thread may still be finishing its connection
+  if (!on_receiver) {
+    wait_recv_idle();
+  }
+
+  _state = ipc_types::cs_connecting;
+
+  if (!_socket->connect()) {
+    _state = ipc_types::cs_closed;
+
+    return false;
+  }
+
+  _connected_at = Clock::now();
+
+  _health.reset(_connected_at);
+
+  if (submit_frame(Opcode::op_handshake, _handshake_frame) !=
+      ipc_types::sr_accepted) {
+    _socket->close();
+
+    _state = ipc_types::cs_closed;
+
+    return false;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(_recv_mutex);
+
+    _stop_recv_thread = false;
+  }
+
+  _recv_cv.notify_all();
+
+  if (!_socket_recv_thread.joinable()) {
+    _socket_recv_thread = std::thread { &DiscordIPCClient::recv_thread, this };
+
+    struct sched_param sch_params;
+    sch_params.sched_priority = 0;
+
+    pthread_setschedparam(
+      _socket_recv_thread.native_handle(), SCHED_OTHER, &sch_params);
+  }
+
+  if (_metrics.increment(metrics::mc_connects) > 1) {
+    _metrics.increment(metrics::mc_reconnects);
+  }
+
+  return true;
+}
+
+bool DiscordIPCClient::close() {
+  bool on_receiver = on_recv_thread();
+  std::unique_lock<std::mutex> lifecycle(_lifecycle_mutex, std::defer_lock);
+
+  // a closure in progress waits for the receive thread, so it never waits
+  if (!on_receiver) {
+    lifecycle.lock();
+  } else if (!lifecycle.try_lock()) {
+    return false;
+  }
+
+  std::vector<PendingRequest> pending;
+  std::vector<std::pair<Clock::time_point, ReadyCallback>> waiters;
+
+  bool closed = close_connection(on_receiver, &pending, &waiters);
+
+  lifecycle.unlock();
+
+  fail_pending(std::move(pending), CommandResponse::rs_closed,
+               "connection closed");
+
+  for (auto& [deadline, callback] : waiters) {
+    callback(false);
+  }
+
+  return closed;
+}
+
+bool DiscordIPCClient::close_connection(
+  bool on_receiver, std::vector<PendingRequest>* pending,
+  std::vector<std::pair<Clock::time_point, ReadyCallback>>* waiters
+) {
+  auto state = _state.load();
+
+  if (state == ipc_types::cs_idle || state == ipc_types::cs_closed) {
+    return false;
+  }
+
+  _state = ipc_types::cs_closing;
+
+  // stop first so the receive thread does not take the closure for a lost
+  // connection and reconnect
+  {
+    std::lock_guard<std::mutex> lock(_recv_mutex);
+
+    _stop_recv_thread = true;
+  }
+
+  _recv_cv.notify_all();
+
+  {
+    std::lock_guard<std::mutex> lock(_ready_mutex);
+
+    _successful_auth = false;
+  }
+
+  // nothing may follow the closure, so drop unsent commands first
+  {
+    std::lock_guard<std::mutex> lock(_write_mutex);
+    std::vector<std::vector<char>> discarded;
+
+    drain_lane(_normal_lane, &discarded, SIZE_MAX);
+  }
+
+  submit_frame(Opcode::op_close, _close_frame);
+
+  *pending = take_pending();
+
+  _presence_scheduler.clear();
+
+  _subscribed_events = 0;
+
+  reset_presence_state();
+
+  {
+    std::lock_guard<std::mutex> lock(_write_mutex);
+    std::vector<std::vector<char>> discarded;
+
+    drain_lane(_control_lane, &discarded, SIZE_MAX);
+    drain_lane(_normal_lane, &discarded, SIZE_MAX);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(_ready_mutex);
+
+    waiters->swap(_ready_waiters);
+  }
+
+  // the receive thread may be polling the socket, so wake it and wait until
+  // it lets go before closing
+  if (!on_receiver) {
+    _socket->interrupt();
+
+    wait_recv_idle();
+  }
+
+  bool closed = _socket->close();
+
+  _state = ipc_types::cs_closed;
+
+  return closed;
+}
+
+ipc_types::ConnectionState DiscordIPCClient::connection_state() const {
+  return _state;
+}
+
+bool DiscordIPCClient::wait_until_ready(std::chrono::milliseconds timeout) {
+  std::unique_lock<std::mutex> lock(_ready_mutex);
+
+  return _ready_cv.wait_for(lock, timeout, [this]() {
+    return _successful_auth.load();
+  });
+}
+
+Awaitable<bool> DiscordIPCClient::async_connect(
+  std::chrono::milliseconds timeout
+) {
+  return Awaitable<bool>([this, timeout](Awaitable<bool>::Completion done) {
+    if (!connect()) {
+      done(false);
+
+      return;
+    }
+
+    add_ready_waiter(on_executor(ReadyCallback(std::move(done))), timeout);
+  });
+}
+
+bool DiscordIPCClient::set_presence(const ipc_types::RichPresence& presence) {
+  DISCORD_IPC_CPP_TRACE_REQUEST();
+
+  if (is_current_presence(presence)) {
+    return true;
+  }
+
+  SendResult result = submit_presence(
+    presence, nullptr, std::chrono::seconds(5));
+
+  return result == ipc_types::sr_accepted || result == ipc_types::sr_held;
+}
+
+std::future<CommandResponse> DiscordIPCClient::set_presence_async(
+  const RichPresence& presence, std::chrono::milliseconds timeout
+) {
+  DISCORD_IPC_CPP_TRACE_REQUEST();
+
+  auto promise = std::make_shared<std::promise<CommandResponse>>();
+
+  if (is_current_presence(presence)) {
+    promise->set_value({ .status = CommandResponse::rs_success });
+  } else {
+    submit_presence(
+      presence,
+      [promise](const CommandResponse& response) {
+        promise->set_value(response);
+      },
+      timeout);
+  }
+
+  return promise->get_future();
+}
+
+void DiscordIPCClient::set_presence_async(
+  const RichPresence& presence,
+  ResponseCallback callback,
+  std::chrono::milliseconds timeout
+) {
+  DISCORD_IPC_CPP_TRACE_REQUEST();
+
+  callback = on_executor(std::move(callback));
+
+  if (is_current_presence(presence)) {
+    if (callback) {
+      callback({ .status = CommandResponse::rs_success });
+    }
+
+    return;
+  }
+
+  submit_presence(presence, std::move(callback), timeout);
+}
+
+ipc_types::PresenceTemplate DiscordIPCClient::make_presence_template(
+  const RichPresence& base
+) const {
+  return ipc_types::PresenceTemplate(base, _pid);
+}
+
+bool DiscordIPCClient::set_presence(
+  const ipc_types::PresenceTemplate& presence_template,
+  const ipc_types::PresenceUpdate& update
+) {
+  DISCORD_IPC_CPP_TRACE_REQUEST();
+
+  if (is_current_presence({ presence_template.id(), update })) {
+    return true;
+  }
+
+  SendResult result = submit_presence(
+    presence_template, update, nullptr, std::chrono::seconds(5));
+
+  return result == ipc_types::sr_accepted || result == ipc_types::sr_held;
+}
+
+std::future<CommandResponse> DiscordIPCClient::set_presence_async(
+  const ipc_types::PresenceTemplate& presence_template,
+  const ipc_types::PresenceUpdate& update,
+  std::chrono::milliseconds timeout
+) {
+  DISCORD_IPC_CPP_TRACE_REQUEST();
+
+  auto promise = std::make_shared<std::promise<CommandResponse>>();
+
+  if (is_current_presence({ presence_template.id(), update })) {
+    promise->set_value({ .status = CommandResponse::rs_success });
+  } else {
+    submit_presence(
+      presence_template,
+      update,
+      [promise](const CommandResponse& response) {
+        promise->set_value(response);
+      },
+      timeout);
+  }
+
+  return promise->get_future();
+}
+
+bool DiscordIPCClient::set_empty_presence() {
+  DISCORD_IPC_CPP_TRACE_REQUEST();
+
+  if (is_current_presence(std::nullopt)) {
+    return true;
+  }
+
+  SendResult result = submit_presence(
+    std::nullopt, nullptr, std::chrono::seconds(5));
+
+  return result == ipc_types::sr_accepted || result == ipc_types::sr_held;
+}
+
+std::future<CommandResponse> DiscordIPCClient::set_empty_presence_async(
+  std::chrono::milliseconds timeout
+) {
+  DISCORD_IPC_CPP_TRACE_REQUEST();
+
+  auto promise = std::make_shared<std::promise<CommandResponse>>();
+
+  if (is_current_presence(std::nullopt)) {
+    promise->set_value({ .status = CommandResponse::rs_success });
+  } else {
+    submit_presence(
+      std::nullopt,
+      [promise](const CommandResponse& response) {
+        promise->set_value(response);
+      },
+      timeout);
+  }
+
+  return promise->get_future();
+}
+
+void DiscordIPCClient::schedule_presence(const RichPresence& presence) {
+  DISCORD_IPC_CPP_TRACE_REQUEST();
+
+  if (is_current_presence(presence)) {
+    return;
+  }
+
+  uint64_t sequence = track_presence(presence);
+
+  if (_presence_scheduler.offer(
+        construct_presence_payload(presence), sequence)) {
+    _metrics.increment(metrics::mc_coalesced_updates);
+  }
+
+  flush_scheduled_presence();
+}
+
+void DiscordIPCClient::schedule_empty_presence() {
+  DISCORD_IPC_CPP_TRACE_REQUEST();
+
+  if (is_current_presence(std::nullopt)) {
+    return;
+  }
+
+  uint64_t sequence = track_presence(std::nullopt);
+
+  if (_presence_scheduler.offer(construct_presence_payload({}), sequence)) {
+    _metrics.increment(metrics::mc_coalesced_updates);
+  }
+
+  flush_scheduled_presence();
+}
+
+void DiscordIPCClient::set_presence_rate_limit(
+  size_t burst, std::chrono::milliseconds period
+) {
+  _presence_scheduler.set_rate_limit(burst, period);
+}
+
+void DiscordIPCClient::set_outbound_budget(size_t bytes) {
+  _outbound_budget = bytes;
+}
+
+void DiscordIPCClient::set_frame_limits(const ipc_types::FrameLimits& limits) {
+  _max_frame_size = limits.max_frame_size;
+  _max_buffered_bytes = limits.max_buffered_bytes;
+}
+
+void DiscordIPCClient::set_capture(
+  std::shared_ptr<capture::CaptureWriter> capture
+) {
+  std::lock_guard<std::mutex> lock(_capture_mutex);
+
+  _capturing = capture != nullptr;
+  _capture = std::move(capture);
+}
+
+DiscordIPCClient::LaneStats DiscordIPCClient::OutboundLane::stats() const {
+  return {
+    .submitted = submitted,
+    .written = written,
+    .rejected = rejected,
+    .queued_bytes = bytes
+  };
+}
+
+DiscordIPCClient::OutboundStats DiscordIPCClient::outbound_stats() const {
+  return {
+    .control = _control_lane.stats(),
+    .normal = _normal_lane.stats()
+  };
+}
+
+void DiscordIPCClient::set_executor(
+  std::shared_ptr<executors::CallbackExecutor> executor
+) {
+  std::lock_guard<std::mutex> lock(_executor_mutex);
+
+  _executor = executor != nullptr
+    ? std::move(executor)
+    : std::make_shared<executors::InlineExecutor>();
+}
+
+void DiscordIPCClient::set_nonce_mode(ipc_types::NonceMode mode) {
+  _nonce_mode = mode;
+}
+
+void DiscordIPCClient::set_health_policy(const health::HealthPolicy& policy) {
+  _health.set_policy(policy);
+}
+
+health::HealthStatus DiscordIPCClient::health_status() const {
+  return _health.status();
+}
+
+void DiscordIPCClient::on_health_change(HealthHandler handler) {
+  handler = on_executor(std::move(handler));
+
+  std::lock_guard<std::mutex> lock(_health_mutex);
+
+  _health_handler = std::move(handler);
+}
+
+logging::Logger& DiscordIPCClient::logger() {
+  return _logger;
+}
+
+metrics::Snapshot DiscordIPCClient::stats() const {
+  return _metrics.snapshot();
+}
+
+Awaitable<CommandResponse> DiscordIPCClient::async_set_presence(
+  const RichPresence& presence, std::chrono::milliseconds timeout
+) {
+  return Awaitable<CommandResponse>(
+    [this, presence, timeout](Awaitable<CommandResponse>::Completion done) {
+      set_presence_async(presence, std::move(done), timeout);
+    });
+}
+
+Awaitable<CommandResponse> DiscordIPCClient::async_set_empty_presence(
+  std::chrono::milliseconds timeout
+) {
+  return Awaitable<CommandResponse>(
+    [this, timeout](Awaitable<CommandResponse>::Completion done) {
+      DISCORD_IPC_CPP_TRACE_REQUEST();
+
+      ResponseCallback callback = on_executor(
+        ResponseCallback(std::move(done)));
+
+      if (is_current_presence(std::nullopt)) {
+        callback({ .status = CommandResponse::rs_success });
+      } else {
+        submit_presence(std::nullopt, std::move(callback), timeout);
+      }
+    });
 }
 }  // namespace discord_ipc_cpp
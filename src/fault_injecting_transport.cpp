@@ -0,0 +1,212 @@
+/*
+  Copyright 2025 Peter Duanmu
+
+  You should have received a copy of the GNU General Public License along
+  with discord_ipc_cpp. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <errno.h>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "discord_ipc_cpp/fault_injecting_transport.hpp"
+
+namespace discord_ipc_cpp::websockets {
+using std::chrono::microseconds;
+using std::chrono::steady_clock;
+
+FaultInjectingTransport::FaultInjectingTransport(
+  std::unique_ptr<Transport> inner, const FaultSchedule& schedule)
+: _inner(std::move(inner)),
+_schedule(schedule),
+_short_reads(0),
+_short_writes(0),
+_would_blocks(0),
+_delayed_us(0),
+_bytes(0),
+_connection_bytes(0),
+_disconnected(false),
+_disconnects(0) {
+  // xorshift requires a non-zero state
+  _send.state = (schedule.seed ^ 0x9e3779b97f4a7c15ULL) | 1;
+  _recv.state = (schedule.seed ^ 0xbf58476d1ce4e5b9ULL) | 1;
+}
+
+double FaultInjectingTransport::next_uniform(Direction& direction) {
+  uint64_t& x = direction.state;
+
+  x ^= x << 13;
+  x ^= x >> 7;
+  x ^= x << 17;
+
+  return (x >> 11) * 0x1.0p-53;
+}
+
+bool FaultInjectingTransport::before_operation(Direction& direction) {
+  std::unique_lock<std::mutex> lock(direction.mutex);
+
+  microseconds delay = _schedule.latency;
+
+  if (_schedule.latency_jitter.count() > 0) {
+    delay += microseconds(static_cast<int64_t>(
+      next_uniform(direction) * _schedule.latency_jitter.count()));
+  }
+
+  auto now = steady_clock::now();
+  auto start = std::max(now + delay, direction.next_transfer);
+
+  bool would_block = next_uniform(direction) <
+                     _schedule.would_block_probability;
+
+  lock.unlock();
+
+  if (start > now) {
+    _delayed_us += std::chrono::duration_cast<microseconds>(
+      start - now).count();
+
+    std::this_thread::sleep_until(start);
+  }
+
+  if (would_block) {
+    ++_would_blocks;
+  }
+
+  return would_block;
+}
+
+size_t FaultInjectingTransport::pick_size(
+  Direction& direction, size_t size, double probability,
+  std::atomic<uint64_t>& counter
+) {
+  std::lock_guard<std::mutex> lock(direction.mutex);
+
+  if (size > 1 && next_uniform(direction) < probability) {
+    ++counter;
+
+    return 1 + static_cast<size_t>(next_uniform(direction) * (size - 1));
+  }
+
+  return size;
+}
+
+void FaultInjectingTransport::after_operation(
+  Direction& direction, size_t size
+) {
+  if (_schedule.bandwidth > 0) {
+    std::lock_guard<std::mutex> lock(direction.mutex);
+
+    auto cost = microseconds(size * 1000000 / _schedule.bandwidth);
+
+    direction.next_transfer =
+      std::max(direction.next_transfer, steady_clock::now()) + cost;
+  }
+
+  _bytes += size;
+
+  uint64_t total = _connection_bytes += size;
+
+  if (_schedule.disconnect_after_bytes.has_value() &&
+      total >= *_schedule.disconnect_after_bytes &&
+      !_disconnected.exchange(true)) {
+    ++_disconnects;
+
+    _inner->close();
+  }
+}
+
+FaultStats FaultInjectingTransport::stats() const {
+  return {
+    .short_reads = _short_reads,
+    .short_writes = _short_writes,
+    .would_blocks = _would_blocks,
+    .delayed = microseconds(_delayed_us),
+    .bytes = _bytes,
+    .disconnected = _disconnected,
+    .disconnects = _disconnects
+  };
+}
+
+bool FaultInjectingTransport::connect() {
+  if (_disconnected && _schedule.permanent_disconnect) {
+    return false;
+  }
+
+  _connection_bytes = 0;
+  _disconnected = false;
+
+  return _inner->connect();
+}
+
+bool FaultInjectingTransport::close() {
+  return _inner->close();
+}
+
+bool FaultInjectingTransport::is_connected() const {
+  return !_disconnected && _inner->is_connected();
+}
+
+void FaultInjectingTransport::interrupt() {
+  _inner->interrupt();
+}
+
+bool FaultInjectingTransport::wait_readable(int timeout) {
+  return _disconnected || _inner->wait_readable(timeout);
+}
+
+bool FaultInjectingTransport::wait_writable(int timeout) {
+  return !_disconnected && _inner->wait_writable(timeout);
+}
+
+ssize_t FaultInjectingTransport::send_some(const char* data, size_t size) {
+  if (_disconnected) {
+    errno = ECONNRESET;
+
+    return -1;
+  }
+
+  if (before_operation(_send)) {
+    errno = EAGAIN;
+
+    return -1;
+  }
+
+  size = pick_size(
+    _send, size, _schedule.short_write_probability, _short_writes);
+
+  ssize_t ret = _inner->send_some(data, size);
+
+  if (ret > 0) {
+    after_operation(_send, ret);
+  }
+
+  return ret;
+}
+
+ssize_t FaultInjectingTransport::recv_some(char* buffer, size_t size) {
+  if (_disconnected) {
+    return 0;
+  }
+
+  if (before_operation(_recv)) {
+    errno = EAGAIN;
+
+    return -1;
+  }
+
+  size = pick_size(
+    _recv, size, _schedule.short_read_probability, _short_reads);
+
+  ssize_t ret = _inner->recv_some(buffer, size);
+
+  if (ret > 0) {
+    after_operation(_recv, ret);
+  }
+
+  return ret;
+}
+}  // namespace discord_ipc_cpp::websockets
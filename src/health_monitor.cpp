@@ -0,0 +1,154 @@
+/*
+  Copyright 2025 Peter Duanmu
+
+  You should have received a copy of the GNU General Public License along
+  with discord_ipc_cpp. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+
+#include "discord_ipc_cpp/health_monitor.hpp"
+
+namespace discord_ipc_cpp::health {
+HealthMonitor::HealthMonitor(const HealthPolicy& policy)
+: _policy(policy),
+_status { .state = hs_healthy, .round_trip {}, .missed_probes = 0 },
+_outstanding(0),
+_last_probe(0),
+_next_due(Clock::now() + policy.interval) {}
+
+void HealthMonitor::update_state() {
+  if (_status.missed_probes >= std::max<uint32_t>(_policy.dead_after, 1)) {
+    _status.state = hs_dead;
+  } else if (_status.missed_probes > 0 ||
+             _status.round_trip > _policy.degraded_round_trip) {
+    _status.state = hs_degraded;
+  } else {
+    _status.state = hs_healthy;
+  }
+}
+
+void HealthMonitor::set_policy(const HealthPolicy& policy) {
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  _policy = policy;
+}
+
+HealthPolicy HealthMonitor::policy() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  return _policy;
+}
+
+void HealthMonitor::reset(Clock::time_point now) {
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  _status = { .state = hs_healthy, .round_trip {}, .missed_probes = 0 };
+  _outstanding = 0;
+  _next_due = now + _policy.interval;
+}
+
+void HealthMonitor::fail(Clock::time_point now) {
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  _status.state = hs_dead;
+  _outstanding = 0;
+  _next_due = now;
+}
+
+std::optional<uint64_t> HealthMonitor::poll(Clock::time_point now) {
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  if (_policy.interval.count() <= 0 || _status.state == hs_dead) {
+    return std::nullopt;
+  }
+
+  if (_outstanding != 0) {
+    if (now - _sent_at < _policy.timeout) {
+      return std::nullopt;
+    }
+
+    ++_status.missed_probes;
+    _outstanding = 0;
+
+    update_state();
+
+    // probe again right away to tell a stall from a single lost reply
+    _next_due = now;
+
+    if (_status.state == hs_dead) {
+      return std::nullopt;
+    }
+  }
+
+  if (now < _next_due) {
+    return std::nullopt;
+  }
+
+  _outstanding = ++_last_probe;
+  _sent_at = now;
+  _next_due = now + _policy.interval;
+
+  return _outstanding;
+}
+
+std::optional<HealthMonitor::Clock::duration> HealthMonitor::acknowledge(
+  uint64_t probe, Clock::time_point now
+) {
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  if (probe == 0 || probe != _outstanding) {
+    return std::nullopt;
+  }
+
+  Clock::duration round_trip = now - _sent_at;
+
+  _status.round_trip = round_trip;
+  _status.missed_probes = 0;
+  _outstanding = 0;
+
+  update_state();
+
+  return round_trip;
+}
+
+bool HealthMonitor::should_reconnect(Clock::time_point now) {
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  if (_status.state != hs_dead || !_policy.reconnect ||
+      _policy.interval.count() <= 0 || now < _next_due) {
+    return false;
+  }
+
+  _next_due = now + _policy.interval;
+
+  return true;
+}
+
+std::optional<HealthMonitor::Clock::duration> HealthMonitor::next_due(
+  Clock::time_point now
+) const {
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  if (_policy.interval.count() <= 0 ||
+      (_status.state == hs_dead && !_policy.reconnect)) {
+    return std::nullopt;
+  }
+
+  Clock::time_point due = _outstanding != 0
+    ? _sent_at + _policy.timeout
+    : _next_due;
+
+  return std::max<Clock::duration>(due - now, Clock::duration::zero());
+}
+
+HealthStatus HealthMonitor::status() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  return _status;
+}
+}  // namespace discord_ipc_cpp::health
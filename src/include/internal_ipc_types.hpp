@@ -16,6 +16,8 @@
 #include "discord_ipc_cpp/json.hpp"
 #include "discord_ipc_cpp/ipc_types.hpp"
 
+#include "include/utils.hpp"
+
 namespace discord_ipc_cpp::internal_ipc_types {
 enum JoinReply {
   jr_no,
@@ -45,16 +47,11 @@ struct CommandRequest {
     ct_subscribe,
     ct_set_activity,
     ct_send_activity_join_invite,
-    ct_close_activity_join_request
+    ct_close_activity_join_request,
+    ct_unknown
   };
 
-  enum EventType {
-    et_error,
-    et_join,
-    et_joinRequest,
-    et_ready,
-    et_spectate
-  };
+  using EventType = ipc_types::EventType;
 
  public:
   const CommandType cmd;
@@ -68,8 +65,22 @@ struct CommandRequest {
   static CommandRequest from_json(const json::JSON& data);
 
  private:
-  static const std::map<CommandType, std::string> _cmd_str_map;
-  static const std::map<EventType, std::string> _evt_str_map;
+  static constexpr utils::EnumTable<CommandType, ct_unknown> _cmd_table {{
+    "DISPATCH",
+    "AUTHORIZE",
+    "SUBSCRIBE",
+    "SET_ACTIVITY",
+    "SEND_ACTIVITY_JOIN_INVITE",
+    "CLOSE_ACTIVITY_JOIN_REQUEST"
+  }};
+  static constexpr utils::EnumTable<EventType, ipc_types::event_type_count>
+    _evt_table {{
+      "ERROR",
+      "ACTIVITY_JOIN",
+      "ACTIVITY_JOIN_REQUEST",
+      "READY",
+      "ACTIVITY_SPECTATE"
+    }};
 };
 
 struct PartialUser {
@@ -8,8 +8,15 @@
 #ifndef DISCORD_IPC_CPP_SRC_INCLUDE_UTILS_HPP_
 #define DISCORD_IPC_CPP_SRC_INCLUDE_UTILS_HPP_
 
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <map>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <optional>
 #include <vector>
 
@@ -21,13 +28,98 @@ std::string find_discord_ipc_file();
 std::string unescape_string(const std::string& input);
 std::string escape_string(const std::string& input);
 
-template<typename T>
-T generate_random_num(T min, T max);
+template<typename Output>
+void append_escaped(Output* output, std::string_view input) {
+  for (char c : input) {
+    if (c == '"') {
+      output->push_back('\\');
+    }
+
+    output->push_back(c);
+  }
+}
+
+inline constexpr size_t uuid_size = 36;
+
+uint64_t random_u64();
+
+void format_uuid(uint64_t high, uint64_t low, char* output);
 
 std::string generate_uuid();
 
-template<typename K, typename V>
-std::optional<K> reverse_map_search(const std::map<K, V>& map, const V& item);
+template<typename T>
+void hash_combine(size_t* seed, const T& value) {
+  *seed ^= std::hash<T>{}(value) + 0x9e3779b97f4a7c15ULL +
+           (*seed << 6) + (*seed >> 2);
+}
+
+// maps the enum values 0 to N - 1 to their names and back. Names are found
+// through a perfect hash whose seed is searched for at compile time, so a
+// lookup is one hash, one table load and one string comparison
+template<typename E, size_t N>
+class EnumTable {
+ private:
+  static constexpr size_t slot_count = std::bit_ceil(N * 2);
+
+  static_assert(N > 0 && N < 255);
+
+  std::array<std::string_view, N> _names;
+  std::array<uint8_t, slot_count> _slots;
+  uint64_t _seed;
+
+  static constexpr uint64_t hash(std::string_view name, uint64_t seed) {
+    uint64_t hash = 0xcbf29ce484222325ULL ^ (seed * 0x9e3779b97f4a7c15ULL);
+
+    for (char c : name) {
+      hash ^= static_cast<uint8_t>(c);
+      hash *= 0x100000001b3ULL;
+    }
+
+    return hash ^ (hash >> 32);
+  }
+
+ public:
+  constexpr explicit EnumTable(const std::array<std::string_view, N>& names)
+  : _names(names), _slots {}, _seed(0) {
+    for (uint64_t seed = 1; seed < (1 << 16); ++seed) {
+      std::array<uint8_t, slot_count> slots {};
+      bool collided = false;
+
+      for (size_t i = 0; i < N && !collided; ++i) {
+        uint8_t& slot = slots[hash(names[i], seed) & (slot_count - 1)];
+
+        collided = slot != 0;
+        slot = static_cast<uint8_t>(i + 1);
+      }
+
+      if (!collided) {
+        _slots = slots;
+        _seed = seed;
+
+        return;
+      }
+    }
+
+    // only reachable with duplicate names, failing the constant evaluation
+    throw std::logic_error("no perfect hash for the enum names");
+  }
+
+  constexpr std::string_view name(E value) const {
+    size_t index = static_cast<size_t>(value);
+
+    return index < N ? _names[index] : std::string_view();
+  }
+
+  constexpr std::optional<E> find(std::string_view name) const {
+    uint8_t slot = _slots[hash(name, _seed) & (slot_count - 1)];
+
+    if (slot == 0 || _names[slot - 1] != name) {
+      return std::nullopt;
+    }
+
+    return static_cast<E>(slot - 1);
+  }
+};
 }  // namespace discord_ipc_cpp::utils
 
 #endif  // DISCORD_IPC_CPP_SRC_INCLUDE_UTILS_HPP_
@@ -7,6 +7,7 @@
 
 #include <map>
 #include <string>
+#include <string_view>
 
 #include "discord_ipc_cpp/json.hpp"
 #include "discord_ipc_cpp/parser.hpp"
@@ -24,8 +25,6 @@ using json::JSON;
 using json::JSONObject;
 using json::Parser;
 
-using discord_ipc_cpp::utils::reverse_map_search;
-
 JSON AuthorizationRequest::to_json() const {
   return JSON({
     { "v", JSON(version) },
@@ -33,31 +32,14 @@ JSON AuthorizationRequest::to_json() const {
   });
 }
 
-const std::map<CommandType, std::string> CommandRequest::_cmd_str_map = {
-  { ct_dispatch, "DISPATCH" },
-  { ct_authorize, "AUTHORIZE" },
-  { ct_subscribe, "SUBSCRIBE" },
-  { ct_set_activity, "SET_ACTIVITY" },
-  { ct_send_activity_join_invite, "SEND_ACTIVITY_JOIN_INVITE" },
-  { ct_close_activity_join_request, "CLOSE_ACTIVITY_JOIN_REQUEST" }
-};
-
-const std::map<EventType, std::string> CommandRequest::_evt_str_map = {
-  { et_error, "ERROR" },
-  { et_join, "ACTIVITY_JOIN" },
-  { et_joinRequest, "ACTIVITY_JOIN_REQUEST" },
-  { et_ready, "READY" },
-  { et_spectate, "SPECTATE" }
-};
-
 JSON CommandRequest::to_json() const {
   JSON base({
-    { "cmd", JSON(_cmd_str_map.at(cmd)) },
+    { "cmd", JSON(std::string(_cmd_table.name(cmd))) },
     { "args", JSON(JSONObject {}) }
   });
 
   if (evt.has_value()) {
-    base["evt"] = JSON(_evt_str_map.at(evt.value()));
+    base["evt"] = JSON(std::string(_evt_table.name(evt.value())));
   }
 
   if (args.has_value()) {
@@ -88,6 +70,7 @@ CommandRequest CommandRequest::from_json(const JSON& data) {
   std::optional<std::map<std::string, RequestArgs>> args;
   std::optional<std::string> nonce;
   std::optional<EventType> evt;
+  CommandType cmd = ct_unknown;
 
   if (data.has("data")) {
     res_data = data["data"];
@@ -105,12 +88,17 @@ CommandRequest CommandRequest::from_json(const JSON& data) {
     nonce = data["nonce"].as<std::string>();
   }
 
+  // names Discord added after this library are kept as unknown
   if (data.has("evt") && data["evt"].is<std::string>()) {
-    evt = *reverse_map_search(_evt_str_map, data["evt"].as<std::string>());
+    evt = _evt_table.find(data["evt"].as<std::string>());
+  }
+
+  if (data.has("cmd") && data["cmd"].is<std::string>()) {
+    cmd = _cmd_table.find(data["cmd"].as<std::string>()).value_or(ct_unknown);
   }
 
   return {
-    .cmd = *reverse_map_search(_cmd_str_map, data["cmd"].as<std::string>()),
+    .cmd = cmd,
     .nonce = nonce,
     .args = args,
     .data = res_data,
@@ -5,17 +5,151 @@
   with discord_ipc_cpp. If not, see <https://www.gnu.org/licenses/>.
 */
 
+#include <cstddef>
+#include <optional>
 #include <string>
 #include <variant>
+#include <vector>
 
 #include "discord_ipc_cpp/ipc_types.hpp"
 #include "discord_ipc_cpp/json.hpp"
 
+#include "include/utils.hpp"
+
 namespace discord_ipc_cpp::ipc_types {
 using discord_ipc_cpp::json::JSON;
 using discord_ipc_cpp::json::JSONObject;
 using discord_ipc_cpp::json::JSONArray;
 
+namespace {
+/**
+ * \brief Retrieves an optional string field of \p data.
+ */
+std::optional<std::string> string_at(const JSON& data, const std::string& key) {
+  auto value = data.safe_at(key);
+
+  if (value.has_value() && value->is<std::string>()) {
+    return value->as<std::string>();
+  }
+
+  return std::nullopt;
+}
+
+/**
+ * \brief Hashes the fields of the nested presence structs.
+ */
+void hash_fields(size_t* seed, const RichPresence::Timestamps& value) {
+  utils::hash_combine(seed, value.start);
+  utils::hash_combine(seed, value.end);
+}
+
+void hash_fields(size_t* seed, const RichPresence::ActivityEmoji& value) {
+  utils::hash_combine(seed, value.name);
+  utils::hash_combine(seed, value.snowflake);
+  utils::hash_combine(seed, value.animated);
+}
+
+void hash_fields(size_t* seed, const RichPresence::Party& value) {
+  utils::hash_combine(seed, value.id);
+  utils::hash_combine(seed, value.size.has_value());
+
+  if (value.size.has_value()) {
+    for (int size : *value.size) {
+      utils::hash_combine(seed, size);
+    }
+  }
+}
+
+void hash_fields(size_t* seed, const RichPresence::Assets& value) {
+  utils::hash_combine(seed, value.large_image);
+  utils::hash_combine(seed, value.large_text);
+  utils::hash_combine(seed, value.large_url);
+  utils::hash_combine(seed, value.small_image);
+  utils::hash_combine(seed, value.small_text);
+  utils::hash_combine(seed, value.small_url);
+}
+
+void hash_fields(size_t* seed, const RichPresence::Secrets& value) {
+  utils::hash_combine(seed, value.join);
+  utils::hash_combine(seed, value.match);
+  utils::hash_combine(seed, value.spectate);
+}
+
+void hash_fields(size_t* seed, const RichPresence::Button& value) {
+  utils::hash_combine(seed, value.label);
+  utils::hash_combine(seed, value.url);
+}
+
+/**
+ * \brief Hashes an optional nested presence struct.
+ */
+template<typename T>
+void hash_optional(size_t* seed, const std::optional<T>& value) {
+  utils::hash_combine(seed, value.has_value());
+
+  if (value.has_value()) {
+    hash_fields(seed, *value);
+  }
+}
+}  // namespace
+
+User User::from_json(const JSON& data) {
+  return {
+    .id = string_at(data, "id").value_or(""),
+    .username = string_at(data, "username").value_or(""),
+    .discriminator = string_at(data, "discriminator"),
+    .global_name = string_at(data, "global_name"),
+    .avatar = string_at(data, "avatar")
+  };
+}
+
+ReadyEvent ReadyEvent::from_json(const JSON& data) {
+  ReadyEvent event;
+
+  auto version = data.safe_at("v");
+  auto user = data.safe_at("user");
+
+  if (version.has_value() && version->is<int>()) {
+    event.version = version->as<int>();
+  }
+
+  if (user.has_value() && user->is<JSONObject>()) {
+    event.user = User::from_json(*user);
+  }
+
+  return event;
+}
+
+ErrorEvent ErrorEvent::from_json(const JSON& data) {
+  ErrorEvent event;
+
+  auto code = data.safe_at("code");
+
+  if (code.has_value() && code->is<int>()) {
+    event.code = code->as<int>();
+  }
+
+  event.message = string_at(data, "message").value_or("");
+
+  return event;
+}
+
+JoinEvent JoinEvent::from_json(const JSON& data) {
+  return { .secret = string_at(data, "secret").value_or("") };
+}
+
+SpectateEvent SpectateEvent::from_json(const JSON& data) {
+  return { .secret = string_at(data, "secret").value_or("") };
+}
+
+JoinRequestEvent JoinRequestEvent::from_json(const JSON& data) {
+  auto user = data.safe_at("user");
+
+  return {
+    .user = user.has_value() ? User::from_json(*user) : User {}
+  };
+}
+
 JSON RichPresence::Timestamps::to_json() const {
   JSON base(JSONObject {});
 
@@ -196,4 +330,35 @@ JSON RichPresence::to_json() const {
 
   return base;
 }
+
+size_t RichPresence::hash() const {
+  size_t seed = 0;
+
+  utils::hash_combine(&seed, name);
+  utils::hash_combine(&seed, type);
+  utils::hash_combine(&seed, url);
+  utils::hash_combine(&seed, created_at);
+  hash_optional(&seed, timestamps);
+  utils::hash_combine(&seed, application_id);
+  utils::hash_combine(&seed, status_display_type);
+  utils::hash_combine(&seed, details);
+  utils::hash_combine(&seed, details_url);
+  utils::hash_combine(&seed, state);
+  utils::hash_combine(&seed, state_url);
+  hash_optional(&seed, emoji);
+  hash_optional(&seed, party);
+  hash_optional(&seed, assets);
+  hash_optional(&seed, secrets);
+  utils::hash_combine(&seed, instance);
+  utils::hash_combine(&seed, flags);
+  utils::hash_combine(&seed, buttons.has_value());
+
+  if (buttons.has_value()) {
+    for (const auto& button : *buttons) {
+      hash_fields(&seed, button);
+    }
+  }
+
+  return seed;
+}
 }  // namespace discord_ipc_cpp::ipc_types
@@ -5,9 +5,10 @@
   with discord_ipc_cpp. If not, see <https://www.gnu.org/licenses/>.
 */
 
-#include <format>
+#include <cstddef>
 #include <string>
 #include <sstream>
+#include <type_traits>
 #include <optional>
 #include <variant>
 #include <vector>
@@ -146,6 +147,33 @@ std::string JSON::to_string() const {
   return os.str();
 }
 
+bool JSON::operator==(const JSON& other) const {
+  return _value == other._value;
+}
+
+size_t JSON::hash() const {
+  size_t seed = _value.index();
+
+  std::visit([&seed](const auto& value) {
+    using T = std::decay_t<decltype(value)>;
+
+    if constexpr (std::is_same_v<T, JSONObject>) {
+      for (const auto& [key, item] : value) {
+        utils::hash_combine(&seed, key);
+        utils::hash_combine(&seed, item);
+      }
+    } else if constexpr (std::is_same_v<T, JSONArray>) {
+      for (const auto& item : value) {
+        utils::hash_combine(&seed, item);
+      }
+    } else {
+      utils::hash_combine(&seed, value);
+    }
+  }, _value);
+
+  return seed;
+}
+
 template JSONString JSON::as<JSONString>() const;
 template JSONInt JSON::as<JSONInt>() const;
 template JSONLong JSON::as<JSONLong>() const;
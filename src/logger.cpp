@@ -0,0 +1,126 @@
+/*
+  Copyright 2025 Peter Duanmu
+
+  You should have received a copy of the GNU General Public License along
+  with discord_ipc_cpp. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "discord_ipc_cpp/logger.hpp"
+
+namespace discord_ipc_cpp::logging {
+std::string_view level_name(LogLevel level) {
+  switch (level) {
+    case ll_trace:
+      return "TRACE";
+    case ll_debug:
+      return "DEBUG";
+    case ll_info:
+      return "INFO";
+    case ll_warning:
+      return "WARNING";
+    case ll_error:
+      return "ERROR";
+    default:
+      return "OFF";
+  }
+}
+
+void StderrSink::write(LogLevel level, std::string_view message) {
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  std::string_view name = level_name(level);
+
+  std::fprintf(stderr, "[discord_ipc_cpp] %.*s: %.*s\n",
+    static_cast<int>(name.size()), name.data(),
+    static_cast<int>(message.size()), message.data());
+}
+
+AsyncRingSink::AsyncRingSink(
+  std::shared_ptr<LogSink> downstream, size_t capacity
+)
+: _downstream(downstream ? std::move(downstream)
+                         : std::make_shared<StderrSink>()),
+_records(capacity),
+_dropped(0),
+_stop(false),
+_worker(&AsyncRingSink::run, this) {}
+
+AsyncRingSink::~AsyncRingSink() {
+  _stop.store(true, std::memory_order_release);
+
+  _worker.join();
+
+  flush();
+}
+
+void AsyncRingSink::run() {
+  auto backoff = std::chrono::microseconds(50);
+
+  while (!_stop.load(std::memory_order_acquire)) {
+    if (_records.has_ready()) {
+      flush();
+
+      backoff = std::chrono::microseconds(50);
+    } else {
+      std::this_thread::sleep_for(backoff);
+
+      backoff = std::min(backoff * 2, std::chrono::microseconds(10000));
+    }
+  }
+}
+
+void AsyncRingSink::write(LogLevel level, std::string_view message) {
+  if (!_records.try_push({ level, std::string(message) })) {
+    _dropped.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void AsyncRingSink::flush() {
+  std::lock_guard<std::mutex> lock(_drain_mutex);
+
+  Record record;
+
+  while (_records.try_pop(&record)) {
+    _downstream->write(record.level, record.message);
+  }
+}
+
+uint64_t AsyncRingSink::dropped() const {
+  return _dropped.load(std::memory_order_relaxed);
+}
+
+Logger::Logger(LogLevel level, std::shared_ptr<LogSink> sink)
+: _level(level),
+_sink(sink ? std::move(sink) : std::make_shared<StderrSink>()) {}
+
+void Logger::write(LogLevel level, std::string_view message) {
+  std::shared_ptr<LogSink> sink;
+
+  {
+    std::lock_guard<std::mutex> lock(_sink_mutex);
+
+    sink = _sink;
+  }
+
+  sink->write(level, message);
+}
+
+void Logger::set_level(LogLevel level) {
+  _level.store(level, std::memory_order_relaxed);
+}
+
+void Logger::set_sink(std::shared_ptr<LogSink> sink) {
+  std::lock_guard<std::mutex> lock(_sink_mutex);
+
+  _sink = sink ? std::move(sink) : std::make_shared<StderrSink>();
+}
+}  // namespace discord_ipc_cpp::logging
@@ -0,0 +1,188 @@
+/*
+  Copyright 2025 Peter Duanmu
+
+  You should have received a copy of the GNU General Public License along
+  with discord_ipc_cpp. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <errno.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <utility>
+
+#include "discord_ipc_cpp/loopback_transport.hpp"
+#include "discord_ipc_cpp/spsc_queue.hpp"
+
+namespace discord_ipc_cpp::websockets {
+namespace {
+/**
+ * \brief Spins until \p ready is satisfied or \p timeout milliseconds pass.
+ */
+template<typename Predicate>
+bool spin_until(Predicate ready, int timeout) {
+  auto deadline = std::chrono::steady_clock::now() +
+                  std::chrono::milliseconds(timeout);
+
+  for (int spins = 0; !ready(); ++spins) {
+    if (timeout >= 0 && std::chrono::steady_clock::now() >= deadline) {
+      return false;
+    }
+
+    if (spins < 64) {
+      std::this_thread::yield();
+    } else {
+      std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+  }
+
+  return true;
+}
+
+}  // namespace
+
+struct LoopbackChannel {
+  /**
+   * \brief Bytes destined for each side.
+   */
+  std::array<std::unique_ptr<queues::SpscQueue<char>>, 2> rings;
+  /**
+   * \brief Serializes concurrent senders into each ring.
+   */
+  std::array<std::atomic_flag, 2> writing;
+  /**
+   * \brief If each side has been opened.
+   */
+  std::array<std::atomic_bool, 2> open { false, false };
+  /**
+   * \brief If each side has been closed.
+   */
+  std::array<std::atomic_bool, 2> closed { false, false };
+};
+
+LoopbackTransport::LoopbackTransport(
+  std::shared_ptr<LoopbackChannel> channel, int side)
+: _channel(std::move(channel)), _side(side) {}
+
+std::pair<
+  std::unique_ptr<LoopbackTransport>,
+  std::unique_ptr<LoopbackTransport>
+> LoopbackTransport::create_pair(size_t capacity) {
+  auto channel = std::make_shared<LoopbackChannel>();
+
+  capacity = std::max<size_t>(capacity, 64);
+
+  channel->rings[0] = std::make_unique<queues::SpscQueue<char>>(capacity);
+  channel->rings[1] = std::make_unique<queues::SpscQueue<char>>(capacity);
+
+  return {
+    std::unique_ptr<LoopbackTransport>(new LoopbackTransport(channel, 0)),
+    std::unique_ptr<LoopbackTransport>(new LoopbackTransport(channel, 1))
+  };
+}
+
+LoopbackTransport::~LoopbackTransport() {
+  close();
+}
+
+bool LoopbackTransport::connect() {
+  // like a socket, the peer must still be listening
+  if (_channel->closed[1 - _side]) {
+    return false;
+  }
+
+  // bytes left from a previous connection must not reach this one
+  auto& ring = *_channel->rings[_side];
+  char discarded[256];
+
+  while (ring.pop_bulk(discarded, sizeof(discarded)) > 0) {}
+
+  _channel->closed[_side] = false;
+  _channel->open[_side] = true;
+  _interrupted = false;
+
+  return true;
+}
+
+bool LoopbackTransport::close() {
+  if (_channel->closed[_side].exchange(true)) {
+    return false;
+  }
+
+  _channel->open[_side] = false;
+
+  return true;
+}
+
+bool LoopbackTransport::is_connected() const {
+  return _channel->open[_side] && !_channel->closed[_side];
+}
+
+void LoopbackTransport::interrupt() {
+  _interrupted = true;
+}
+
+bool LoopbackTransport::wait_readable(int timeout) {
+  auto& ring = *_channel->rings[_side];
+  auto& peer_closed = _channel->closed[1 - _side];
+
+  return spin_until([&]() {
+    return ring.size() > 0 || peer_closed || _interrupted;
+  }, timeout);
+}
+
+bool LoopbackTransport::wait_writable(int timeout) {
+  auto& ring = *_channel->rings[1 - _side];
+  auto& self_closed = _channel->closed[_side];
+  auto& peer_closed = _channel->closed[1 - _side];
+
+  return spin_until([&]() {
+    return ring.free_space() > 0 || self_closed || peer_closed;
+  }, timeout) && !self_closed && !peer_closed;
+}
+
+ssize_t LoopbackTransport::send_some(const char* data, size_t size) {
+  auto& ring = *_channel->rings[1 - _side];
+  auto& writing = _channel->writing[1 - _side];
+  auto& self_closed = _channel->closed[_side];
+  auto& peer_closed = _channel->closed[1 - _side];
+
+  while (writing.test_and_set(std::memory_order_acquire)) {
+    std::this_thread::yield();
+  }
+
+  size_t sent = 0;
+
+  spin_until([&]() {
+    sent = self_closed || peer_closed ? 0 : ring.push_bulk(data, size);
+
+    return sent > 0 || self_closed || peer_closed;
+  }, -1);
+
+  writing.clear(std::memory_order_release);
+
+  if (sent == 0) {
+    errno = EPIPE;
+
+    return -1;
+  }
+
+  return sent;
+}
+
+ssize_t LoopbackTransport::recv_some(char* buffer, size_t size) {
+  if (_channel->closed[_side]) {
+    errno = EBADF;
+
+    return -1;
+  }
+
+  wait_readable(-1);
+
+  return _channel->rings[_side]->pop_bulk(buffer, size);
+}
+}  // namespace discord_ipc_cpp::websockets
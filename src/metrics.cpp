@@ -0,0 +1,83 @@
+/*
+  Copyright 2025 Peter Duanmu
+
+  You should have received a copy of the GNU General Public License along
+  with discord_ipc_cpp. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+
+#include "discord_ipc_cpp/metrics.hpp"
+
+namespace discord_ipc_cpp::metrics {
+uint64_t HistogramSnapshot::percentile(double percentile) const {
+  if (count == 0) {
+    return 0;
+  }
+
+  percentile = std::clamp(percentile, 0.0, 100.0);
+
+  auto target = std::max<uint64_t>(
+    1, static_cast<uint64_t>(std::ceil(percentile / 100 * count)));
+  uint64_t seen = 0;
+
+  for (size_t i = 0; i < buckets.size(); ++i) {
+    seen += buckets[i];
+
+    if (seen >= target) {
+      return std::min(LatencyHistogram::bucket_upper_bound(i), max);
+    }
+  }
+
+  return max;
+}
+
+double HistogramSnapshot::mean() const {
+  return count == 0 ? 0 : static_cast<double>(sum) / count;
+}
+
+HistogramSnapshot LatencyHistogram::snapshot() const {
+  HistogramSnapshot snapshot {
+    .count = 0,
+    .sum = _sum.load(std::memory_order_relaxed),
+    .max = _max.load(std::memory_order_relaxed),
+    .buckets = std::vector<uint64_t>(bucket_count)
+  };
+
+  // derive the count from the buckets so percentiles stay consistent
+  for (size_t i = 0; i < bucket_count; ++i) {
+    snapshot.buckets[i] = _buckets[i].load(std::memory_order_relaxed);
+    snapshot.count += snapshot.buckets[i];
+  }
+
+  return snapshot;
+}
+
+Snapshot Registry::snapshot() const {
+  Snapshot snapshot;
+
+  for (size_t i = 0; i < opcode_count; ++i) {
+    snapshot.opcodes[i] = {
+      .frames_sent = _opcodes[i].frames_sent.load(std::memory_order_relaxed),
+      .bytes_sent = _opcodes[i].bytes_sent.load(std::memory_order_relaxed),
+      .frames_received =
+        _opcodes[i].frames_received.load(std::memory_order_relaxed),
+      .bytes_received =
+        _opcodes[i].bytes_received.load(std::memory_order_relaxed)
+    };
+  }
+
+  for (size_t i = 0; i < counter_count; ++i) {
+    snapshot.counters[i] = _counters[i].load(std::memory_order_relaxed);
+  }
+
+  for (size_t i = 0; i < timer_count; ++i) {
+    snapshot.timers[i] = _timers[i].snapshot();
+  }
+
+  return snapshot;
+}
+}  // namespace discord_ipc_cpp::metrics
@@ -0,0 +1,137 @@
+/*
+  Copyright 2025 Peter Duanmu
+
+  You should have received a copy of the GNU General Public License along
+  with discord_ipc_cpp. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+#include "discord_ipc_cpp/presence_scheduler.hpp"
+
+namespace discord_ipc_cpp::scheduling {
+using ipc_types::Payload;
+
+SlidingWindow::SlidingWindow(size_t limit, Clock::duration period)
+: _limit(std::max<size_t>(limit, 1)), _period(period) {}
+
+void SlidingWindow::expire(Clock::time_point now) {
+  while (!_sends.empty() && now - _sends.front() >= _period) {
+    _sends.pop_front();
+  }
+}
+
+bool SlidingWindow::try_acquire(Clock::time_point now) {
+  expire(now);
+
+  if (_sends.size() >= _limit) {
+    return false;
+  }
+
+  _sends.push_back(now);
+
+  return true;
+}
+
+void SlidingWindow::refund() {
+  if (!_sends.empty()) {
+    _sends.pop_back();
+  }
+}
+
+SlidingWindow::Clock::duration SlidingWindow::time_until_available(
+  Clock::time_point now
+) {
+  expire(now);
+
+  if (_sends.size() < _limit) {
+    return Clock::duration::zero();
+  }
+
+  return _sends.front() + _period - now;
+}
+
+PresenceScheduler::PresenceScheduler(size_t burst, Clock::duration period)
+: _window(burst, period), _pending_sequence(0), _coalesced(0) {}
+
+void PresenceScheduler::set_rate_limit(
+  size_t burst, Clock::duration period
+) {
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  _window = SlidingWindow(burst, period);
+}
+
+bool PresenceScheduler::offer(const Payload& payload, uint64_t sequence) {
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  bool superseded = _pending.has_value();
+
+  if (superseded) {
+    ++_coalesced;
+  }
+
+  _pending.emplace(payload);
+  _pending_sequence = sequence;
+
+  return superseded;
+}
+
+std::optional<Payload> PresenceScheduler::poll(
+  Clock::time_point now, uint64_t* sequence
+) {
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  if (!_pending.has_value() || !_window.try_acquire(now)) {
+    return std::nullopt;
+  }
+
+  std::optional<Payload> payload(std::move(_pending));
+
+  if (sequence != nullptr) {
+    *sequence = _pending_sequence;
+  }
+
+  _pending.reset();
+
+  return payload;
+}
+
+void PresenceScheduler::restore(const Payload& payload, uint64_t sequence) {
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  _window.refund();
+
+  if (!_pending.has_value()) {
+    _pending.emplace(payload);
+    _pending_sequence = sequence;
+  }
+}
+
+void PresenceScheduler::clear() {
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  _pending.reset();
+}
+
+std::optional<PresenceScheduler::Clock::duration>
+PresenceScheduler::next_release(Clock::time_point now) {
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  if (!_pending.has_value()) {
+    return std::nullopt;
+  }
+
+  return _window.time_until_available(now);
+}
+
+uint64_t PresenceScheduler::coalesced() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  return _coalesced;
+}
+}  // namespace discord_ipc_cpp::scheduling
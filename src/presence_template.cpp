@@ -0,0 +1,167 @@
+/*
+  Copyright 2025 Peter Duanmu
+
+  You should have received a copy of the GNU General Public License along
+  with discord_ipc_cpp. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstring>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "discord_ipc_cpp/ipc_types.hpp"
+#include "discord_ipc_cpp/presence_template.hpp"
+
+#include "include/internal_ipc_types.hpp"
+#include "include/utils.hpp"
+
+namespace discord_ipc_cpp::ipc_types {
+using discord_ipc_cpp::internal_ipc_types::CommandRequest;
+
+namespace {
+/**
+ * \brief Serialized slots of the skeleton presence, in serialization order.
+ *
+ * Object keys are serialized in sorted order, and each slot is followed by a
+ * comma as \c name and \c type are always serialized after it. Unescaped
+ * quotes never appear inside serialized strings, so each slot occurs once.
+ */
+constexpr std::array<std::string_view, 3> slots = {
+  "\"details\":\"\",",
+  "\"state\":\"\",",
+  "\"timestamps\":{},"
+};
+
+constexpr std::string_view nonce_key = "\"nonce\":\"";
+constexpr size_t nonce_size = 36;
+
+std::atomic<uint64_t> next_template_id { 1 };
+}  // namespace
+
+PresenceTemplate::PresenceTemplate(const RichPresence& base, int pid)
+: _id(next_template_id.fetch_add(1, std::memory_order_relaxed)),
+_nonce_offset(0) {
+  RichPresence skeleton = base;
+
+  skeleton.details = "";
+  skeleton.state = "";
+  skeleton.timestamps = RichPresence::Timestamps {};
+
+  std::string body = CommandRequest {
+    .cmd = CommandRequest::ct_set_activity,
+    .nonce = std::string(nonce_size, '0'),
+    .args = std::map<std::string, CommandRequest::RequestArgs> {
+      { "activity", skeleton },
+      { "pid", pid }
+    },
+    .data = std::nullopt,
+    .evt = std::nullopt
+  }.to_json().to_string();
+
+  size_t start = 0;
+
+  for (size_t i = 0; i < slots.size(); ++i) {
+    size_t slot = body.find(slots[i], start);
+
+    _fragments[i] = body.substr(start, slot - start);
+
+    start = slot + slots[i].size();
+  }
+
+  _fragments.back() = body.substr(start);
+  _nonce_offset = _fragments.back().find(nonce_key) + nonce_key.size();
+}
+
+uint64_t PresenceTemplate::id() const {
+  return _id;
+}
+
+std::vector<char> PresenceTemplate::render(
+  const PresenceUpdate& update, std::string_view nonce
+) const {
+  std::vector<char> packet(8);
+  size_t reserved = packet.size() + 64;
+
+  for (const auto& fragment : _fragments) {
+    reserved += fragment.size();
+  }
+
+  // escaping at most doubles each string
+  reserved += 2 * (update.details ? update.details->size() : 0) +
+              2 * (update.state ? update.state->size() : 0);
+
+  packet.reserve(reserved);
+
+  auto append = [&packet](std::string_view data) {
+    packet.insert(packet.end(), data.begin(), data.end());
+  };
+
+  append(_fragments[0]);
+
+  if (update.details.has_value()) {
+    append("\"details\":\"");
+    utils::append_escaped(&packet, *update.details);
+    append("\",");
+  }
+
+  append(_fragments[1]);
+
+  if (update.state.has_value()) {
+    append("\"state\":\"");
+    utils::append_escaped(&packet, *update.state);
+    append("\",");
+  }
+
+  append(_fragments[2]);
+
+  if (update.timestamps.has_value()) {
+    const auto& timestamps = *update.timestamps;
+    char buffer[16];
+
+    append("\"timestamps\":{");
+
+    if (timestamps.end.has_value()) {
+      auto end = std::to_chars(
+        buffer, buffer + sizeof(buffer), *timestamps.end);
+
+      append("\"end\":");
+      append(std::string_view(buffer, end.ptr - buffer));
+
+      if (timestamps.start.has_value()) {
+        append(",");
+      }
+    }
+
+    if (timestamps.start.has_value()) {
+      auto end = std::to_chars(
+        buffer, buffer + sizeof(buffer), *timestamps.start);
+
+      append("\"start\":");
+      append(std::string_view(buffer, end.ptr - buffer));
+    }
+
+    append("},");
+  }
+
+  size_t nonce_at = packet.size() + _nonce_offset;
+
+  append(_fragments[3]);
+
+  std::memcpy(
+    &packet[nonce_at], nonce.data(), std::min(nonce.size(), nonce_size));
+
+  int opcode = Opcode::op_frame;
+  int data_len = packet.size() - 8;
+
+  std::memcpy(&packet[0], &opcode, 4);
+  std::memcpy(&packet[4], &data_len, 4);
+
+  return packet;
+}
+}  // namespace discord_ipc_cpp::ipc_types
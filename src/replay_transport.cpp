@@ -0,0 +1,206 @@
+/*
+  Copyright 2025 Peter Duanmu
+
+  You should have received a copy of the GNU General Public License along
+  with discord_ipc_cpp. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <errno.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "discord_ipc_cpp/capture.hpp"
+#include "discord_ipc_cpp/replay_transport.hpp"
+
+namespace discord_ipc_cpp::websockets {
+ReplayTransport::ReplayTransport(
+  std::shared_ptr<const capture::CaptureReader> capture, double speed)
+: _capture(std::move(capture)),
+_origin(0),
+_speed(speed),
+_connected(false),
+_interrupted(false),
+_next(0),
+_offset(0) {
+  const auto& frames = _capture->frames();
+
+  if (!frames.empty()) {
+    _origin = frames.front().timestamp;
+  }
+
+  for (size_t i = 0; i < frames.size(); ++i) {
+    if (frames[i].direction == capture::cd_inbound) {
+      _inbound.push_back(i);
+    }
+  }
+}
+
+ReplayTransport::Clock::time_point ReplayTransport::due(
+  size_t position
+) const {
+  if (_speed <= 0) {
+    return _start;
+  }
+
+  int64_t offset = _capture->frames()[_inbound[position]].timestamp - _origin;
+
+  return _start + std::chrono::duration_cast<Clock::duration>(
+    std::chrono::duration<double, std::nano>(offset / _speed));
+}
+
+bool ReplayTransport::wait_due(
+  std::unique_lock<std::mutex>& lock, Clock::time_point deadline
+) {
+  while (_connected && !_interrupted && _next < _inbound.size()) {
+    Clock::time_point frame_due = due(_next);
+
+    if (Clock::now() >= frame_due) {
+      return true;
+    }
+
+    if (_cv.wait_until(lock, std::min(frame_due, deadline)) ==
+          std::cv_status::timeout &&
+        Clock::now() >= deadline) {
+      return false;
+    }
+  }
+
+  return _connected;
+}
+
+bool ReplayTransport::finished() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  return _next >= _inbound.size();
+}
+
+bool ReplayTransport::connect() {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    _connected = true;
+    _interrupted = false;
+    _start = Clock::now();
+    _next = 0;
+    _offset = 0;
+  }
+
+  _cv.notify_all();
+
+  return true;
+}
+
+bool ReplayTransport::close() {
+  bool was_connected;
+
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    was_connected = _connected.exchange(false);
+  }
+
+  _cv.notify_all();
+
+  return was_connected;
+}
+
+bool ReplayTransport::is_connected() const {
+  return _connected;
+}
+
+void ReplayTransport::interrupt() {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    _interrupted = true;
+  }
+
+  _cv.notify_all();
+}
+
+bool ReplayTransport::wait_readable(int timeout) {
+  std::unique_lock<std::mutex> lock(_mutex);
+
+  Clock::time_point deadline = timeout < 0
+    ? Clock::time_point::max()
+    : Clock::now() + std::chrono::milliseconds(timeout);
+
+  return wait_due(lock, deadline);
+}
+
+bool ReplayTransport::wait_writable(int) {
+  return _connected;
+}
+
+ssize_t ReplayTransport::send_some(const char*, size_t size) {
+  if (!_connected) {
+    errno = ENOTCONN;
+
+    return -1;
+  }
+
+  return size;
+}
+
+ssize_t ReplayTransport::recv_some(char* buffer, size_t size) {
+  std::unique_lock<std::mutex> lock(_mutex);
+
+  if (!wait_due(lock, Clock::time_point::max())) {
+    errno = ENOTCONN;
+
+    return -1;
+  }
+
+  if (_next >= _inbound.size()) {
+    // the capture ended, so Discord closed the connection
+    _connected = false;
+
+    return 0;
+  }
+
+  if (_interrupted && Clock::now() < due(_next)) {
+    return 0;
+  }
+
+  const capture::FrameRecord& frame = _capture->frames()[_inbound[_next]];
+
+  char header[8];
+  int32_t length = static_cast<int32_t>(frame.payload.size());
+
+  std::memcpy(header, &frame.opcode, 4);
+  std::memcpy(header + 4, &length, 4);
+
+  size_t frame_size = 8 + frame.payload.size();
+  size_t received = 0;
+
+  while (received < size && _offset < frame_size) {
+    size_t step;
+
+    if (_offset < 8) {
+      step = std::min(size - received, 8 - _offset);
+
+      std::memcpy(buffer + received, header + _offset, step);
+    } else {
+      step = std::min(size - received, frame_size - _offset);
+
+      std::memcpy(
+        buffer + received, frame.payload.data() + _offset - 8, step);
+    }
+
+    received += step;
+    _offset += step;
+  }
+
+  if (_offset == frame_size) {
+    ++_next;
+    _offset = 0;
+  }
+
+  return received;
+}
+}  // namespace discord_ipc_cpp::websockets
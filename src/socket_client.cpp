@@ -7,23 +7,28 @@
 
 #include <poll.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
+#include <cstring>
 #include <string>
-#include <optional>
-#include <vector>
 
 #include "discord_ipc_cpp/socket_client.hpp"
 
 namespace discord_ipc_cpp::websockets {
+namespace {
+// writing to a socket closed by Discord must fail instead of raising SIGPIPE,
+// which Linux suppresses per call and macOS per socket
+#ifdef MSG_NOSIGNAL
+constexpr int send_flags = MSG_NOSIGNAL;
+#else
+constexpr int send_flags = 0;
+#endif
+}  // namespace
+
 SocketClient::SocketClient(
   const std::string& socket_file)
-: _socket_file(socket_file) {
-  int opt = 1;
-
-  _client_socket = ::socket(AF_UNIX, SOCK_STREAM, 0);
-  setsockopt(_client_socket, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
-
+: _socket_file(socket_file), _client_socket(-1), _connected(false) {
   std::memset(&_server_addr, 0, sizeof(_server_addr));
 
   _server_addr.sun_family = AF_UNIX;
@@ -40,6 +45,19 @@ SocketClient::~SocketClient() {
 }
 
 bool SocketClient::connect() {
+  // a closed socket cannot be reconnected, so open a fresh one
+  if (_client_socket < 0) {
+    int opt = 1;
+
+    _client_socket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    setsockopt(_client_socket, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+#ifdef SO_NOSIGPIPE
+    setsockopt(_client_socket, SOL_SOCKET, SO_NOSIGPIPE, &opt, sizeof(opt));
+#endif
+
+    _fds[0].fd = _client_socket;
+  }
+
   if (_client_socket < 0) {
     return false;
   }
@@ -48,10 +66,14 @@ bool SocketClient::connect() {
                       reinterpret_cast<const sockaddr*>(&_server_addr),
                       sizeof(sockaddr_un));
 
-  return ret != -1;
+  _connected = ret != -1;
+
+  return _connected;
 }
 
 bool SocketClient::close() {
+  _connected = false;
+
   if (_client_socket > 0) {
     ::close(_client_socket);
 
@@ -63,37 +85,73 @@ bool SocketClient::close() {
   }
 }
 
-bool SocketClient::send_data(const std::vector<char>& data) {
+bool SocketClient::is_connected() const {
+  return _connected;
+}
+
+void SocketClient::interrupt() {
+  if (_client_socket >= 0) {
+    ::shutdown(_client_socket, SHUT_RDWR);
+  }
+}
+
+bool SocketClient::wait_readable(int timeout) {
   if (_client_socket < 0) {
     return false;
   }
 
-  int ret = ::send(_client_socket, data.data(), data.size(), 0);
+  int ret = ::poll(_fds, 1, timeout);
 
-  return ret != -1;
+  return ret > 0 && (_fds[0].revents & (POLLIN | POLLHUP));
 }
 
-std::optional<std::vector<char>> SocketClient::recv_data(int buffer_size) {
-  std::vector<char> buffer(buffer_size);
+bool SocketClient::wait_writable(int timeout) {
+  if (_client_socket < 0) {
+    return false;
+  }
+
+  struct pollfd fds[1] = {{ _client_socket, POLLOUT, 0 }};
 
-  int ret = ::recv(_client_socket, buffer.data(), buffer.size(), 0);
+  int ret = ::poll(fds, 1, timeout);
 
-  if (ret == -1) {
-    return std::nullopt;
+  return ret > 0 && (fds[0].revents & POLLOUT);
+}
+
+ssize_t SocketClient::send_some(const char* data, size_t size) {
+  if (_client_socket < 0) {
+    return -1;
   }
 
-  return buffer;
+  return ::send(_client_socket, data, size, send_flags);
 }
 
-std::optional<std::vector<char>> SocketClient::recv_data(
-  int buffer_size, int timeout
+ssize_t SocketClient::send_some_vectored(
+  const struct iovec* buffers, int count
 ) {
-  int ret = ::poll(_fds, 1, timeout);
+  if (_client_socket < 0) {
+    return -1;
+  }
 
-  if (ret > 0 && _fds[0].revents & POLLIN) {
-    return recv_data(buffer_size);
-  } else {
-    return std::nullopt;
+  struct msghdr message;
+  std::memset(&message, 0, sizeof(message));
+
+  message.msg_iov = const_cast<struct iovec*>(buffers);
+  message.msg_iovlen = count;
+
+  return ::sendmsg(_client_socket, &message, send_flags);
+}
+
+ssize_t SocketClient::recv_some(char* buffer, size_t size) {
+  if (_client_socket < 0) {
+    return -1;
   }
+
+  ssize_t ret = ::recv(_client_socket, buffer, size, 0);
+
+  if (ret == 0 && size > 0) {
+    _connected = false;
+  }
+
+  return ret;
 }
 }  // namespace discord_ipc_cpp::websockets
@@ -0,0 +1,233 @@
+/*
+  Copyright 2025 Peter Duanmu
+
+  You should have received a copy of the GNU General Public License along
+  with discord_ipc_cpp. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "discord_ipc_cpp/tracing.hpp"
+
+namespace discord_ipc_cpp::tracing {
+namespace {
+/**
+ * \brief Slot of a thread's ring.
+ *
+ * Fields are relaxed atomics so that exporting while the owner overwrites a
+ * slot is well-defined, and torn slots are detected through the ring's head.
+ */
+struct Slot {
+  std::atomic<const char*> name { nullptr };
+  std::atomic<uint64_t> request { 0 };
+  std::atomic<int64_t> start { 0 };
+  std::atomic<int64_t> duration { 0 };
+};
+
+/**
+ * \brief Spans recorded by a single thread.
+ */
+struct ThreadRing {
+  /**
+   * \brief Sequential ID of the thread, used as the trace's \c tid.
+   */
+  uint32_t thread;
+  /**
+   * \brief Number of spans ever recorded, written by the owning thread.
+   */
+  std::atomic<size_t> head { 0 };
+  /**
+   * \brief Recorded spans.
+   */
+  std::array<Slot, ring_capacity> slots;
+};
+
+/**
+ * \brief Rings of every thread that recorded a span.
+ *
+ * Rings outlive their threads so spans of finished threads are exported.
+ */
+struct Registry {
+  std::mutex mutex;
+  std::vector<std::shared_ptr<ThreadRing>> rings;
+};
+
+Registry& registry() {
+  static Registry instance;
+
+  return instance;
+}
+
+ThreadRing& local_ring() {
+  thread_local std::shared_ptr<ThreadRing> ring = []() {
+    auto created = std::make_shared<ThreadRing>();
+    Registry& rings = registry();
+    std::lock_guard<std::mutex> lock(rings.mutex);
+
+    created->thread = rings.rings.size() + 1;
+
+    rings.rings.push_back(created);
+
+    return created;
+  }();
+
+  return *ring;
+}
+
+int64_t to_ns(Clock::time_point time) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    time.time_since_epoch()).count();
+}
+
+thread_local uint64_t current_request_id = 0;
+
+std::atomic<uint64_t> next_request_id { 1 };
+}  // namespace
+
+void record(
+  const char* name,
+  Clock::time_point start,
+  Clock::time_point end,
+  uint64_t request
+) {
+  if constexpr (!enabled) {
+    return;
+  }
+
+  ThreadRing& ring = local_ring();
+  size_t head = ring.head.load(std::memory_order_relaxed);
+  Slot& slot = ring.slots[head % ring_capacity];
+
+  slot.name.store(name, std::memory_order_relaxed);
+  slot.request.store(request, std::memory_order_relaxed);
+  slot.start.store(to_ns(start), std::memory_order_relaxed);
+  slot.duration.store(to_ns(end) - to_ns(start), std::memory_order_relaxed);
+
+  ring.head.store(head + 1, std::memory_order_release);
+}
+
+uint64_t current_request() {
+  return current_request_id;
+}
+
+RequestScope::RequestScope() : _previous(current_request_id) {
+  current_request_id = next_request_id.fetch_add(
+    1, std::memory_order_relaxed);
+}
+
+RequestScope::~RequestScope() {
+  current_request_id = _previous;
+}
+
+std::string export_chrome_trace() {
+  std::vector<std::shared_ptr<ThreadRing>> rings;
+
+  {
+    Registry& all = registry();
+    std::lock_guard<std::mutex> lock(all.mutex);
+
+    rings = all.rings;
+  }
+
+  std::string trace = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  bool first = true;
+  char buffer[256];
+  int pid = getpid();
+
+  for (const auto& ring : rings) {
+    size_t head = ring->head.load(std::memory_order_acquire);
+    size_t begin = head > ring_capacity ? head - ring_capacity : 0;
+
+    struct Span {
+      const char* name;
+      uint64_t request;
+      int64_t start;
+      int64_t duration;
+    };
+
+    std::vector<Span> spans;
+
+    spans.reserve(head - begin);
+
+    for (size_t i = begin; i < head; ++i) {
+      const Slot& slot = ring->slots[i % ring_capacity];
+
+      spans.push_back({
+        slot.name.load(std::memory_order_relaxed),
+        slot.request.load(std::memory_order_relaxed),
+        slot.start.load(std::memory_order_relaxed),
+        slot.duration.load(std::memory_order_relaxed)
+      });
+    }
+
+    // skip slots the owner may have overwritten while they were copied,
+    // including the one it may still be writing before publishing it
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    size_t after = ring->head.load(std::memory_order_relaxed);
+    size_t skip = after + 1 > ring_capacity + begin
+      ? std::min(after + 1 - ring_capacity - begin, spans.size())
+      : 0;
+
+    for (size_t i = skip; i < spans.size(); ++i) {
+      const Span& span = spans[i];
+
+      if (span.name == nullptr) {
+        continue;
+      }
+
+      std::snprintf(buffer, sizeof(buffer),
+        "%s{\"name\":\"%s\",\"cat\":\"discord_ipc_cpp\",\"ph\":\"X\","
+        "\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%u,"
+        "\"args\":{\"request\":%llu}}",
+        first ? "" : ",", span.name, span.start / 1000.0,
+        span.duration / 1000.0, pid, ring->thread,
+        static_cast<unsigned long long>(span.request));  // NOLINT
+
+      trace += buffer;
+
+      first = false;
+    }
+  }
+
+  trace += "]}";
+
+  return trace;
+}
+
+bool write_chrome_trace(const std::string& path) {
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+  if (!file) {
+    return false;
+  }
+
+  file << export_chrome_trace();
+
+  return static_cast<bool>(file);
+}
+
+void clear() {
+  Registry& all = registry();
+  std::lock_guard<std::mutex> lock(all.mutex);
+
+  // only the owning thread writes a ring, so mark its slots as empty instead
+  for (const auto& ring : all.rings) {
+    for (auto& slot : ring->slots) {
+      slot.name.store(nullptr, std::memory_order_relaxed);
+    }
+  }
+}
+}  // namespace discord_ipc_cpp::tracing
@@ -0,0 +1,179 @@
+/*
+  Copyright 2025 Peter Duanmu
+
+  You should have received a copy of the GNU General Public License along
+  with discord_ipc_cpp. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <errno.h>
+#include <sys/uio.h>
+
+#include <algorithm>
+#include <climits>
+#include <optional>
+#include <vector>
+
+#include "discord_ipc_cpp/transport.hpp"
+
+namespace discord_ipc_cpp::websockets {
+namespace {
+/**
+ * \brief Checks if a failed operation may be retried.
+ */
+bool is_transient_error() {
+  return errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK;
+}
+}  // namespace
+
+void Transport::interrupt() {}
+
+bool Transport::send_data(const std::vector<char>& data) {
+  size_t offset = 0;
+
+  while (offset < data.size()) {
+    ssize_t ret = send_some(data.data() + offset, data.size() - offset);
+
+    if (ret < 0 && is_transient_error()) {
+      if (errno != EINTR && !wait_writable(-1)) {
+        return false;
+      }
+
+      continue;
+    }
+
+    if (ret <= 0) {
+      return false;
+    }
+
+    offset += ret;
+  }
+
+  return true;
+}
+
+ssize_t Transport::send_some_vectored(const struct iovec* buffers, int count) {
+  for (int i = 0; i < count; ++i) {
+    if (buffers[i].iov_len > 0) {
+      return send_some(
+        static_cast<const char*>(buffers[i].iov_base), buffers[i].iov_len);
+    }
+  }
+
+  return 0;
+}
+
+bool Transport::send_data(const std::vector<std::vector<char>>& buffers) {
+  std::vector<struct iovec> pending;
+
+  pending.reserve(buffers.size());
+
+  for (const auto& buffer : buffers) {
+    if (!buffer.empty()) {
+      pending.push_back({
+        .iov_base = const_cast<char*>(buffer.data()),
+        .iov_len = buffer.size()
+      });
+    }
+  }
+
+  size_t first = 0;
+
+  while (first < pending.size()) {
+    ssize_t ret = send_some_vectored(
+      &pending[first],
+      static_cast<int>(std::min<size_t>(pending.size() - first, IOV_MAX)));
+
+    if (ret < 0 && is_transient_error()) {
+      if (errno != EINTR && !wait_writable(-1)) {
+        return false;
+      }
+
+      continue;
+    }
+
+    if (ret <= 0) {
+      return false;
+    }
+
+    // skip fully sent buffers and trim a partially sent one
+    for (size_t sent = ret; sent > 0;) {
+      size_t step = std::min(sent, pending[first].iov_len);
+
+      pending[first].iov_base = static_cast<char*>(
+        pending[first].iov_base) + step;
+      pending[first].iov_len -= step;
+      sent -= step;
+
+      if (pending[first].iov_len == 0) {
+        ++first;
+      }
+    }
+  }
+
+  return true;
+}
+
+std::optional<std::vector<char>> Transport::recv_data(int buffer_size) {
+  if (buffer_size < 0) {
+    return std::nullopt;
+  }
+
+  std::vector<char> buffer(buffer_size);
+
+  if (!recv_exact(buffer.data(), buffer.size())) {
+    return std::nullopt;
+  }
+
+  return buffer;
+}
+
+bool Transport::recv_exact(char* buffer, size_t size) {
+  size_t offset = 0;
+
+  while (offset < size) {
+    ssize_t ret = recv_some(buffer + offset, size - offset);
+
+    if (ret < 0 && is_transient_error()) {
+      if (errno != EINTR && !wait_readable(-1)) {
+        return false;
+      }
+
+      continue;
+    }
+
+    if (ret <= 0) {
+      return false;
+    }
+
+    offset += ret;
+  }
+
+  return true;
+}
+
+bool Transport::discard_data(size_t size) {
+  char chunk[4096];
+
+  while (size > 0) {
+    size_t step = std::min(size, sizeof(chunk));
+
+    if (!recv_exact(chunk, step)) {
+      return false;
+    }
+
+    size -= step;
+  }
+
+  return true;
+}
+
+std::optional<std::vector<char>> Transport::recv_data(
+  int buffer_size, int timeout
+) {
+  if (wait_readable(timeout)) {
+    return recv_data(buffer_size);
+  } else {
+    return std::nullopt;
+  }
+}
+}  // namespace discord_ipc_cpp::websockets
@@ -7,26 +7,24 @@
 
 #include <unistd.h>
 
+#include <array>
+#include <cstdint>
 #include <map>
 #include <string>
 #include <optional>
-#include <vector>
 #include <random>
 #include <regex>
 
 #include "include/utils.hpp"
-#include "include/internal_ipc_types.hpp"
 
 namespace discord_ipc_cpp::utils {
-using CommandType = internal_ipc_types::CommandRequest::CommandType;
-using EventType = internal_ipc_types::CommandRequest::EventType;
-
 const std::map<std::string, std::string> _escape_key {
   {"\\\"", "\""}
 };
 
 std::string find_discord_ipc_file() {
-  std::string user_tmp_dir = std::getenv("TMPDIR");
+  const char* tmp_dir = std::getenv("TMPDIR");
+  std::string user_tmp_dir = tmp_dir != nullptr ? tmp_dir : "/tmp/";
   std::string base_ipc_name = "discord-ipc-";
 
   for (int i = 0; i < 10; ++i) {
@@ -51,60 +49,115 @@ std::string unescape_string(const std::string& input) {
 }
 
 std::string escape_string(const std::string& input) {
-  std::string output = input;
+  std::string output;
 
-  for (const auto& [key, value] : _escape_key) {
-    output = std::regex_replace(output, std::regex(value), key);
-  }
+  output.reserve(input.size());
+
+  append_escaped(&output, input);
 
   return output;
 }
 
-template<typename T>
-T generate_random_num(T min, T max) {
-  static std::random_device _rdev;
-  static std::mt19937 _rng(_rdev());
-  static std::uniform_real_distribution<> _rdist(min, max);
+namespace {
+constexpr std::array<std::array<char, 2>, 256> make_hex_table() {
+  constexpr char digits[] = "0123456789abcdef";
+  std::array<std::array<char, 2>, 256> table {};
 
-  return _rdist(_rng);
+  for (int i = 0; i < 256; ++i) {
+    table[i] = { digits[i >> 4], digits[i & 0xf] };
+  }
+
+  return table;
 }
 
-std::string generate_uuid() {
-  static const std::string _valid_chars = "0123456789abcdef";
-  static const std::vector<int> _dashes = {
-    0, 0, 0, 0, 1, 0, 1, 0, 1, 0, 1, 0, 0, 0, 0, 0
-  };
+constexpr auto hex_table = make_hex_table();
 
-  std::string uuid = "";
+uint64_t splitmix64(uint64_t* state) {
+  uint64_t z = (*state += 0x9e3779b97f4a7c15ULL);
 
-  for (int i = 0; i < 16; ++i) {
-    if (_dashes[i]) {
-      uuid += '-';
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+
+  return z ^ (z >> 31);
+}
+
+/**
+ * \brief xoshiro256** generator, seeded once per thread.
+ */
+class Xoshiro256 {
+ private:
+  std::array<uint64_t, 4> _state;
+
+  static uint64_t rotl(uint64_t value, int shift) {
+    return (value << shift) | (value >> (64 - shift));
+  }
+
+ public:
+  Xoshiro256() {
+    std::random_device device;
+    uint64_t seed = (static_cast<uint64_t>(device()) << 32) ^ device();
+
+    for (auto& word : _state) {
+      word = splitmix64(&seed);
     }
+  }
+
+  uint64_t next() {
+    uint64_t result = rotl(_state[1] * 5, 7) * 9;
+    uint64_t t = _state[1] << 17;
 
-    uuid += _valid_chars[generate_random_num(0, 15)];
-    uuid += _valid_chars[generate_random_num(0, 15)];
+    _state[2] ^= _state[0];
+    _state[3] ^= _state[1];
+    _state[1] ^= _state[2];
+    _state[0] ^= _state[3];
+    _state[2] ^= t;
+    _state[3] = rotl(_state[3], 45);
+
+    return result;
   }
+};
 
-  return uuid;
+Xoshiro256& thread_rng() {
+  thread_local Xoshiro256 rng;
+
+  return rng;
+}
+}  // namespace
+
+uint64_t random_u64() {
+  return thread_rng().next();
 }
 
-template<typename K, typename V>
-std::optional<K> reverse_map_search(const std::map<K, V>& map, const V& item) {
-  for (const auto& [key, value] : map) {
-    if (value == item) {
-      return key;
+void format_uuid(uint64_t high, uint64_t low, char* output) {
+  // byte offsets of the dashes in 8-4-4-4-12 form
+  static constexpr std::array<bool, 16> dash_before = {
+    0, 0, 0, 0, 1, 0, 1, 0, 1, 0, 1, 0, 0, 0, 0, 0
+  };
+
+  for (int i = 0; i < 16; ++i) {
+    uint64_t word = i < 8 ? high : low;
+    auto byte = static_cast<uint8_t>(word >> (56 - 8 * (i % 8)));
+
+    if (dash_before[i]) {
+      *output++ = '-';
     }
-  }
 
-  return std::nullopt;
+    *output++ = hex_table[byte][0];
+    *output++ = hex_table[byte][1];
+  }
 }
 
-template double generate_random_num(double, double);
-template int generate_random_num(int, int);
+std::string generate_uuid() {
+  Xoshiro256& rng = thread_rng();
+
+  // version 4 and the RFC 4122 variant
+  uint64_t high = (rng.next() & ~0xf000ULL) | 0x4000ULL;
+  uint64_t low = (rng.next() & ~(0xc0ULL << 56)) | (0x80ULL << 56);
 
-template std::optional<CommandType> reverse_map_search(
-  const std::map<CommandType, std::string>&, const std::string& item);
-template std::optional<EventType> reverse_map_search(
-  const std::map<EventType, std::string>&, const std::string& item);
+  std::string uuid(uuid_size, '\0');
+
+  format_uuid(high, low, uuid.data());
+
+  return uuid;
+}
 }  // namespace discord_ipc_cpp::utils
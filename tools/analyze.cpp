@@ -0,0 +1,373 @@
+/*
+  Copyright 2025 Peter Duanmu
+
+  You should have received a copy of the GNU General Public License along
+  with discord_ipc_cpp. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+// Summarizes a capture written by discord_ipc_cpp::capture::CaptureWriter:
+// the opcode and command mix, payload sizes, nonce round trips and error
+// rates. Frames are parsed in parallel, one contiguous slice per thread.
+//
+// Usage: discord_ipc_analyze <capture> [threads]
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <map>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "discord_ipc_cpp/capture.hpp"
+#include "discord_ipc_cpp/ipc_types.hpp"
+#include "discord_ipc_cpp/json.hpp"
+#include "discord_ipc_cpp/metrics.hpp"
+#include "discord_ipc_cpp/parser.hpp"
+
+namespace {
+using discord_ipc_cpp::capture::CaptureReader;
+using discord_ipc_cpp::capture::FrameRecord;
+using discord_ipc_cpp::json::JSON;
+using discord_ipc_cpp::json::JSONString;
+using discord_ipc_cpp::json::Parser;
+using discord_ipc_cpp::metrics::opcode_count;
+
+namespace capture = discord_ipc_cpp::capture;
+namespace ipc_types = discord_ipc_cpp::ipc_types;
+
+constexpr std::array<const char*, opcode_count> opcode_names = {
+  "HANDSHAKE", "FRAME", "CLOSE", "PING", "PONG"
+};
+
+constexpr std::array<const char*, 2> direction_names = {
+  "sent", "received"
+};
+
+/**
+ * \brief Nonce seen in a frame.
+ */
+struct NonceSighting {
+  std::string nonce;
+  capture::Direction direction;
+  int64_t timestamp;
+};
+
+/**
+ * \brief Aggregates of a slice of the capture.
+ */
+struct Tally {
+  std::array<std::array<uint64_t, opcode_count + 1>, 2> frames {};
+  std::array<std::array<uint64_t, opcode_count + 1>, 2> bytes {};
+  std::array<std::map<std::string, uint64_t>, 2> commands;
+  std::array<std::vector<double>, 2> sizes;
+  std::vector<NonceSighting> nonces;
+  uint64_t parsed = 0;
+  uint64_t parse_failures = 0;
+  uint64_t error_events = 0;
+
+  /**
+   * \brief Folds the aggregates of another slice into this one.
+   */
+  void merge(Tally&& other) {
+    for (size_t direction = 0; direction < 2; ++direction) {
+      for (size_t opcode = 0; opcode <= opcode_count; ++opcode) {
+        frames[direction][opcode] += other.frames[direction][opcode];
+        bytes[direction][opcode] += other.bytes[direction][opcode];
+      }
+
+      for (const auto& [command, count] : other.commands[direction]) {
+        commands[direction][command] += count;
+      }
+
+      sizes[direction].insert(
+        sizes[direction].end(),
+        other.sizes[direction].begin(), other.sizes[direction].end());
+    }
+
+    nonces.insert(nonces.end(),
+                  std::make_move_iterator(other.nonces.begin()),
+                  std::make_move_iterator(other.nonces.end()));
+
+    parsed += other.parsed;
+    parse_failures += other.parse_failures;
+    error_events += other.error_events;
+  }
+};
+
+/**
+ * \brief Reads a string field of a command, if present.
+ */
+std::string string_field(const JSON& command, const JSONString& key) {
+  auto field = command.safe_at(key);
+
+  if (!field.has_value()) {
+    return {};
+  }
+
+  return field->safe_as<JSONString>().value_or("");
+}
+
+/**
+ * \brief Aggregates the frames in \c [begin,end).
+ */
+void analyze(const std::vector<FrameRecord>& frames, size_t begin,
+             size_t end, Tally* tally) {
+  for (size_t i = begin; i < end; ++i) {
+    const FrameRecord& frame = frames[i];
+
+    size_t direction = frame.direction == capture::cd_inbound ? 1 : 0;
+    size_t opcode =
+      frame.opcode >= 0 && static_cast<size_t>(frame.opcode) < opcode_count
+        ? frame.opcode
+        : opcode_count;
+
+    ++tally->frames[direction][opcode];
+    tally->bytes[direction][opcode] += frame.payload.size();
+    tally->sizes[direction].push_back(frame.payload.size());
+
+    // heartbeats carry arbitrary payloads, so only commands are parsed
+    if (opcode != ipc_types::op_frame || frame.payload.empty()) {
+      continue;
+    }
+
+    JSON command;
+
+    try {
+      command = Parser::parse(std::string(frame.payload));
+
+      ++tally->parsed;
+    } catch (const std::exception&) {
+      ++tally->parse_failures;
+
+      continue;
+    }
+
+    std::string cmd = string_field(command, "cmd");
+    std::string evt = string_field(command, "evt");
+    std::string nonce = string_field(command, "nonce");
+
+    if (cmd.empty()) {
+      cmd = "<none>";
+    }
+
+    if (!evt.empty()) {
+      cmd += " " + evt;
+    }
+
+    ++tally->commands[direction][cmd];
+
+    if (direction == 1 && evt == "ERROR") {
+      ++tally->error_events;
+    }
+
+    if (!nonce.empty()) {
+      tally->nonces.push_back({
+        .nonce = std::move(nonce),
+        .direction = frame.direction,
+        .timestamp = frame.timestamp
+      });
+    }
+  }
+}
+
+/**
+ * \brief Prints the distribution of \p samples as a single row.
+ */
+void print_distribution(const char* name, const char* unit,
+                        std::vector<double> samples) {
+  if (samples.empty()) {
+    std::printf("  %-10s n=0\n", name);
+
+    return;
+  }
+
+  std::sort(samples.begin(), samples.end());
+
+  auto percentile = [&](double p) {
+    return samples[static_cast<size_t>(p * (samples.size() - 1))];
+  };
+
+  double sum = 0;
+
+  for (double sample : samples) {
+    sum += sample;
+  }
+
+  std::printf(
+    "  %-10s n=%-8zu min=%.2f%s p50=%.2f%s p90=%.2f%s p99=%.2f%s "
+    "max=%.2f%s mean=%.2f%s\n",
+    name, samples.size(), samples.front(), unit, percentile(0.50), unit,
+    percentile(0.90), unit, percentile(0.99), unit, samples.back(), unit,
+    sum / samples.size(), unit);
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    std::fprintf(stderr, "usage: %s <capture> [threads]\n", argv[0]);
+
+    return 2;
+  }
+
+  size_t threads = argc > 2
+    ? std::strtoul(argv[2], nullptr, 10)
+    : std::thread::hardware_concurrency();
+
+  threads = std::max<size_t>(threads, 1);
+
+  CaptureReader reader;
+
+  if (!reader.open(argv[1])) {
+    std::fprintf(stderr, "%s is not a readable capture\n", argv[1]);
+
+    return 1;
+  }
+
+  const auto& frames = reader.frames();
+
+  threads = std::min(threads, std::max<size_t>(frames.size(), 1));
+
+  auto start = std::chrono::steady_clock::now();
+
+  std::vector<Tally> tallies(threads);
+  std::vector<std::thread> workers;
+
+  for (size_t t = 0; t < threads; ++t) {
+    size_t begin = frames.size() * t / threads;
+    size_t end = frames.size() * (t + 1) / threads;
+
+    workers.emplace_back(analyze, std::cref(frames), begin, end, &tallies[t]);
+  }
+
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  Tally total;
+
+  for (auto& tally : tallies) {
+    total.merge(std::move(tally));
+  }
+
+  // replies are matched to commands in capture order, so an ERROR reply to
+  // a command counts as answered
+  std::unordered_map<std::string, int64_t> outstanding;
+  std::vector<double> round_trips;
+  uint64_t unmatched = 0;
+
+  for (const auto& sighting : total.nonces) {
+    if (sighting.direction == capture::cd_outbound) {
+      outstanding[sighting.nonce] = sighting.timestamp;
+
+      continue;
+    }
+
+    auto sent = outstanding.find(sighting.nonce);
+
+    if (sent == outstanding.end()) {
+      ++unmatched;
+
+      continue;
+    }
+
+    round_trips.push_back((sighting.timestamp - sent->second) / 1e6);
+
+    outstanding.erase(sent);
+  }
+
+  double elapsed = std::chrono::duration<double, std::milli>(
+    std::chrono::steady_clock::now() - start).count();
+
+  uint64_t total_bytes = 0;
+
+  for (const auto& direction : total.bytes) {
+    for (uint64_t bytes : direction) {
+      total_bytes += bytes;
+    }
+  }
+
+  std::printf("%zu frames, %.2f MiB of payloads", frames.size(),
+              total_bytes / 1048576.0);
+
+  if (frames.size() > 1) {
+    std::printf(" over %.3fs",
+                (frames.back().timestamp - frames.front().timestamp) / 1e9);
+  }
+
+  std::printf(", %llu overwritten before capture ended\n",
+              static_cast<unsigned long long>(reader.overwritten()));
+  std::printf("analyzed in %.2fms on %zu threads\n\n", elapsed, threads);
+
+  for (size_t direction = 0; direction < 2; ++direction) {
+    std::printf("%s opcodes:\n", direction_names[direction]);
+
+    for (size_t opcode = 0; opcode <= opcode_count; ++opcode) {
+      if (total.frames[direction][opcode] == 0) {
+        continue;
+      }
+
+      std::printf("  %-10s %10llu frames %12llu bytes\n",
+                  opcode < opcode_count ? opcode_names[opcode] : "UNKNOWN",
+                  static_cast<unsigned long long>(
+                    total.frames[direction][opcode]),
+                  static_cast<unsigned long long>(
+                    total.bytes[direction][opcode]));
+    }
+
+    std::printf("%s commands:\n", direction_names[direction]);
+
+    std::vector<std::pair<std::string, uint64_t>> commands(
+      total.commands[direction].begin(), total.commands[direction].end());
+
+    std::sort(commands.begin(), commands.end(),
+              [](const auto& a, const auto& b) { return a.second > b.second; });
+
+    for (const auto& [command, count] : commands) {
+      std::printf("  %-32s %10llu\n", command.c_str(),
+                  static_cast<unsigned long long>(count));
+    }
+
+    std::printf("\n");
+  }
+
+  std::printf("payload sizes:\n");
+  print_distribution("sent", "B", std::move(total.sizes[0]));
+  print_distribution("received", "B", std::move(total.sizes[1]));
+
+  std::printf("\nround trips:\n");
+  print_distribution("nonce", "ms", std::move(round_trips));
+  std::printf("  %zu commands unanswered, %llu replies without a command\n",
+              outstanding.size(), static_cast<unsigned long long>(unmatched));
+
+  uint64_t received_commands = 0;
+
+  for (const auto& [command, count] : total.commands[1]) {
+    received_commands += count;
+  }
+
+  auto rate = [](uint64_t count, uint64_t total) {
+    return total > 0 ? 100.0 * count / total : 0.0;
+  };
+
+  std::printf("\nerrors:\n");
+  std::printf("  ERROR events    %10llu (%.2f%% of received commands)\n",
+              static_cast<unsigned long long>(total.error_events),
+              rate(total.error_events, received_commands));
+  std::printf("  parse failures  %10llu (%.2f%% of command frames)\n",
+              static_cast<unsigned long long>(total.parse_failures),
+              rate(total.parse_failures,
+                   total.parsed + total.parse_failures));
+  std::printf("  closures        %10llu\n",
+              static_cast<unsigned long long>(
+                total.frames[1][ipc_types::op_close]));
+
+  return 0;
+}